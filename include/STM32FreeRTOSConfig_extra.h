@@ -0,0 +1,40 @@
+#ifndef STM32_FREERTOS_CONFIG_EXTRA_H
+#define STM32_FREERTOS_CONFIG_EXTRA_H
+
+// Project settings, included by the STM32FreeRTOS library before its FreeRTOSConfig_Default.h
+
+// Tickless idle: when every task is blocked, the idle task stops the 1 ms tick and sleeps (WFI) until
+// the next task timeout or an interrupt (touch, DMA, LTDC...), about 77 ms at most with the 24 bit
+// SysTick at 216 MHz. Build with -DconfigUSE_TICKLESS_IDLE=0 to keep the tick interrupt running.
+#ifndef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE 1
+#endif
+
+#if configUSE_TICKLESS_IDLE && !defined(__ASSEMBLER__)
+#include <stdint.h>
+
+// The Arduino core counts the HAL tick (millis(), HAL timeouts) in the same SysTick interrupt as the
+// kernel tick. After a sleep the kernel steps over the suppressed ticks, the HAL tick takes the same step.
+extern volatile uint32_t uwTick;
+#define traceINCREASE_TICK_COUNT(ticks) (uwTick += (ticks))
+#endif
+
+// Profiling mode (-DTASK_PROFILING=1, see lib/taskProfiler): the run time of each task is counted in
+// core clock cycles by the DWT cycle counter, and the stacks are checked on every context switch
+// (a task which overflows its stack makes the LED blink three times).
+#if defined(TASK_PROFILING) && TASK_PROFILING
+#define configGENERATE_RUN_TIME_STATS 1
+#define configCHECK_FOR_STACK_OVERFLOW 2
+
+#ifndef __ASSEMBLER__
+#ifdef __cplusplus
+extern "C"
+#endif
+void taskProfilerStartCounter(void);
+#endif
+
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() taskProfilerStartCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE() (*(volatile uint32_t *)0xE0001004UL) // DWT->CYCCNT
+#endif
+
+#endif // STM32_FREERTOS_CONFIG_EXTRA_H
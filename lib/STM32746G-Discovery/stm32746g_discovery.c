@@ -27,6 +27,7 @@ EndDependencies */
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm32746g_discovery.h"
+#include "i2cBus.h"
 
 /** @addtogroup BSP
   * @{
@@ -104,9 +105,6 @@ const uint16_t COM_TX_AF[COMn] = {DISCOVERY_COM1_TX_AF};
 
 const uint16_t COM_RX_AF[COMn] = {DISCOVERY_COM1_RX_AF};
 
-static I2C_HandleTypeDef hI2cAudioHandler = {0};
-static I2C_HandleTypeDef hI2cExtHandler = {0};
-
 /**
   * @}
   */
@@ -114,13 +112,11 @@ static I2C_HandleTypeDef hI2cExtHandler = {0};
 /** @defgroup STM32746G_DISCOVERY_LOW_LEVEL_Private_FunctionPrototypes STM32746G_DISCOVERY_LOW_LEVEL Private Function Prototypes
   * @{
   */
-static void     I2Cx_MspInit(I2C_HandleTypeDef *i2c_handler);
-static void     I2Cx_Init(I2C_HandleTypeDef *i2c_handler);
+static void     I2Cx_Init(I2cBusId bus);
 
-static HAL_StatusTypeDef I2Cx_ReadMultiple(I2C_HandleTypeDef *i2c_handler, uint8_t Addr, uint16_t Reg, uint16_t MemAddSize, uint8_t *Buffer, uint16_t Length);
-static HAL_StatusTypeDef I2Cx_WriteMultiple(I2C_HandleTypeDef *i2c_handler, uint8_t Addr, uint16_t Reg, uint16_t MemAddSize, uint8_t *Buffer, uint16_t Length);
-static HAL_StatusTypeDef I2Cx_IsDeviceReady(I2C_HandleTypeDef *i2c_handler, uint16_t DevAddress, uint32_t Trials);
-static void              I2Cx_Error(I2C_HandleTypeDef *i2c_handler, uint8_t Addr);
+static HAL_StatusTypeDef I2Cx_ReadMultiple(I2cBusId bus, I2cPriority priority, uint8_t Addr, uint16_t Reg, uint16_t MemAddSize, uint8_t *Buffer, uint16_t Length);
+static HAL_StatusTypeDef I2Cx_WriteMultiple(I2cBusId bus, I2cPriority priority, uint8_t Addr, uint16_t Reg, uint16_t MemAddSize, uint8_t *Buffer, uint16_t Length);
+static HAL_StatusTypeDef I2Cx_IsDeviceReady(I2cBusId bus, I2cPriority priority, uint16_t DevAddress, uint32_t Trials);
 
 /* AUDIO IO functions */
 void            AUDIO_IO_Init(void);
@@ -441,129 +437,23 @@ void BSP_COM_DeInit(COM_TypeDef COM, UART_HandleTypeDef *huart)
 *******************************************************************************/
 
 /******************************* I2C Routines *********************************/
-/**
-  * @brief  Initializes I2C MSP.
-  * @param  i2c_handler : I2C handler
-  * @retval None
-  */
-static void I2Cx_MspInit(I2C_HandleTypeDef *i2c_handler)
-{
-  GPIO_InitTypeDef  gpio_init_structure;
-  
-  if (i2c_handler == (I2C_HandleTypeDef*)(&hI2cAudioHandler))
-  {
-    /* AUDIO and LCD I2C MSP init */
-
-    /*** Configure the GPIOs ***/
-    /* Enable GPIO clock */
-    DISCOVERY_AUDIO_I2Cx_SCL_SDA_GPIO_CLK_ENABLE();
-
-    /* Configure I2C Tx as alternate function */
-    gpio_init_structure.Pin = DISCOVERY_AUDIO_I2Cx_SCL_PIN;
-    gpio_init_structure.Mode = GPIO_MODE_AF_OD;
-    gpio_init_structure.Pull = GPIO_NOPULL;
-    gpio_init_structure.Speed = GPIO_SPEED_FAST;
-    gpio_init_structure.Alternate = DISCOVERY_AUDIO_I2Cx_SCL_SDA_AF;
-    HAL_GPIO_Init(DISCOVERY_AUDIO_I2Cx_SCL_SDA_GPIO_PORT, &gpio_init_structure);
-
-    /* Configure I2C Rx as alternate function */
-    gpio_init_structure.Pin = DISCOVERY_AUDIO_I2Cx_SDA_PIN;
-    HAL_GPIO_Init(DISCOVERY_AUDIO_I2Cx_SCL_SDA_GPIO_PORT, &gpio_init_structure);
-
-    /*** Configure the I2C peripheral ***/
-    /* Enable I2C clock */
-    DISCOVERY_AUDIO_I2Cx_CLK_ENABLE();
-
-    /* Force the I2C peripheral clock reset */
-    DISCOVERY_AUDIO_I2Cx_FORCE_RESET();
-
-    /* Release the I2C peripheral clock reset */
-    DISCOVERY_AUDIO_I2Cx_RELEASE_RESET();
-
-    /* Enable and set I2Cx Interrupt to a lower priority */
-    HAL_NVIC_SetPriority(DISCOVERY_AUDIO_I2Cx_EV_IRQn, 0x0F, 0);
-    HAL_NVIC_EnableIRQ(DISCOVERY_AUDIO_I2Cx_EV_IRQn);
-
-    /* Enable and set I2Cx Interrupt to a lower priority */
-    HAL_NVIC_SetPriority(DISCOVERY_AUDIO_I2Cx_ER_IRQn, 0x0F, 0);
-    HAL_NVIC_EnableIRQ(DISCOVERY_AUDIO_I2Cx_ER_IRQn);
-  }
-  else
-  {
-    /* External, camera and Arduino connector I2C MSP init */
-
-    /*** Configure the GPIOs ***/
-    /* Enable GPIO clock */
-    DISCOVERY_EXT_I2Cx_SCL_SDA_GPIO_CLK_ENABLE();
-
-    /* Configure I2C Tx as alternate function */
-    gpio_init_structure.Pin = DISCOVERY_EXT_I2Cx_SCL_PIN;
-    gpio_init_structure.Mode = GPIO_MODE_AF_OD;
-    gpio_init_structure.Pull = GPIO_NOPULL;
-    gpio_init_structure.Speed = GPIO_SPEED_FAST;
-    gpio_init_structure.Alternate = DISCOVERY_EXT_I2Cx_SCL_SDA_AF;
-    HAL_GPIO_Init(DISCOVERY_EXT_I2Cx_SCL_SDA_GPIO_PORT, &gpio_init_structure);
-
-    /* Configure I2C Rx as alternate function */
-    gpio_init_structure.Pin = DISCOVERY_EXT_I2Cx_SDA_PIN;
-    HAL_GPIO_Init(DISCOVERY_EXT_I2Cx_SCL_SDA_GPIO_PORT, &gpio_init_structure);
-
-    /*** Configure the I2C peripheral ***/
-    /* Enable I2C clock */
-    DISCOVERY_EXT_I2Cx_CLK_ENABLE();
-
-    /* Force the I2C peripheral clock reset */
-    DISCOVERY_EXT_I2Cx_FORCE_RESET();
-
-    /* Release the I2C peripheral clock reset */
-    DISCOVERY_EXT_I2Cx_RELEASE_RESET();
-
-    /* Enable and set I2Cx Interrupt to a lower priority */
-    HAL_NVIC_SetPriority(DISCOVERY_EXT_I2Cx_EV_IRQn, 0x0F, 0);
-    HAL_NVIC_EnableIRQ(DISCOVERY_EXT_I2Cx_EV_IRQn);
-
-    /* Enable and set I2Cx Interrupt to a lower priority */
-    HAL_NVIC_SetPriority(DISCOVERY_EXT_I2Cx_ER_IRQn, 0x0F, 0);
-    HAL_NVIC_EnableIRQ(DISCOVERY_EXT_I2Cx_ER_IRQn);
-  }
-}
+/* The transfers are queued to the shared I2C scheduler (i2cBus library): the calling
+   task sleeps during the transfer and the touch screen reads go before the EEPROM. */
 
 /**
   * @brief  Initializes I2C HAL.
-  * @param  i2c_handler : I2C handler
+  * @param  bus : I2C bus
   * @retval None
   */
-static void I2Cx_Init(I2C_HandleTypeDef *i2c_handler)
+static void I2Cx_Init(I2cBusId bus)
 {
-  if(HAL_I2C_GetState(i2c_handler) == HAL_I2C_STATE_RESET)
-  {
-    if (i2c_handler == (I2C_HandleTypeDef*)(&hI2cAudioHandler))
-    {
-      /* Audio and LCD I2C configuration */
-      i2c_handler->Instance = DISCOVERY_AUDIO_I2Cx;
-    }
-    else
-    {
-      /* External, camera and Arduino connector  I2C configuration */
-      i2c_handler->Instance = DISCOVERY_EXT_I2Cx;
-    }
-    i2c_handler->Init.Timing           = DISCOVERY_I2Cx_TIMING;
-    i2c_handler->Init.OwnAddress1      = 0;
-    i2c_handler->Init.AddressingMode   = I2C_ADDRESSINGMODE_7BIT;
-    i2c_handler->Init.DualAddressMode  = I2C_DUALADDRESS_DISABLE;
-    i2c_handler->Init.OwnAddress2      = 0;
-    i2c_handler->Init.GeneralCallMode  = I2C_GENERALCALL_DISABLE;
-    i2c_handler->Init.NoStretchMode    = I2C_NOSTRETCH_DISABLE;
-
-    /* Init the I2C */
-    I2Cx_MspInit(i2c_handler);
-    HAL_I2C_Init(i2c_handler);
-  }
+  i2cBusBegin(bus);
 }
 
 /**
   * @brief  Reads multiple data.
-  * @param  i2c_handler : I2C handler
+  * @param  bus : I2C bus
+  * @param  priority : Priority class of the transfer
   * @param  Addr: I2C address
   * @param  Reg: Reg address 
   * @param  MemAddress: Memory address 
@@ -571,29 +461,22 @@ static void I2Cx_Init(I2C_HandleTypeDef *i2c_handler)
   * @param  Length: Length of the data
   * @retval Number of read data
   */
-static HAL_StatusTypeDef I2Cx_ReadMultiple(I2C_HandleTypeDef *i2c_handler,
+static HAL_StatusTypeDef I2Cx_ReadMultiple(I2cBusId bus,
+                                           I2cPriority priority,
                                            uint8_t Addr,
                                            uint16_t Reg,
                                            uint16_t MemAddress,
                                            uint8_t *Buffer,
                                            uint16_t Length)
 {
-  HAL_StatusTypeDef status = HAL_OK;
-
-  status = HAL_I2C_Mem_Read(i2c_handler, Addr, (uint16_t)Reg, MemAddress, Buffer, Length, 1000);
-
-  /* Check the communication status */
-  if(status != HAL_OK)
-  {
-    /* I2C error occurred */
-    I2Cx_Error(i2c_handler, Addr);
-  }
-  return status;    
+  /* The scheduler restarts the bus after an error */
+  return i2cBusRead(bus, priority, Addr, Reg, MemAddress, Buffer, Length);
 }
 
 /**
-  * @brief  Writes a value in a register of the device through BUS in using DMA mode.
-  * @param  i2c_handler : I2C handler
+  * @brief  Writes a value in a register of the device through BUS.
+  * @param  bus : I2C bus
+  * @param  priority : Priority class of the transfer
   * @param  Addr: Device address on BUS Bus.  
   * @param  Reg: The target register address to write
   * @param  MemAddress: Memory address 
@@ -601,52 +484,29 @@ static HAL_StatusTypeDef I2Cx_ReadMultiple(I2C_HandleTypeDef *i2c_handler,
   * @param  Length: buffer size to be written
   * @retval HAL status
   */
-static HAL_StatusTypeDef I2Cx_WriteMultiple(I2C_HandleTypeDef *i2c_handler,
+static HAL_StatusTypeDef I2Cx_WriteMultiple(I2cBusId bus,
+                                            I2cPriority priority,
                                             uint8_t Addr,
                                             uint16_t Reg,
                                             uint16_t MemAddress,
                                             uint8_t *Buffer,
                                             uint16_t Length)
 {
-  HAL_StatusTypeDef status = HAL_OK;
-  
-  status = HAL_I2C_Mem_Write(i2c_handler, Addr, (uint16_t)Reg, MemAddress, Buffer, Length, 1000);
-  
-  /* Check the communication status */
-  if(status != HAL_OK)
-  {
-    /* Re-Initiaize the I2C Bus */
-    I2Cx_Error(i2c_handler, Addr);
-  }
-  return status;
+  return i2cBusWrite(bus, priority, Addr, Reg, MemAddress, Buffer, Length);
 }
 
 /**
   * @brief  Checks if target device is ready for communication. 
   * @note   This function is used with Memory devices
-  * @param  i2c_handler : I2C handler
+  * @param  bus : I2C bus
+  * @param  priority : Priority class of the polls
   * @param  DevAddress: Target device address
   * @param  Trials: Number of trials
   * @retval HAL status
   */
-static HAL_StatusTypeDef I2Cx_IsDeviceReady(I2C_HandleTypeDef *i2c_handler, uint16_t DevAddress, uint32_t Trials)
+static HAL_StatusTypeDef I2Cx_IsDeviceReady(I2cBusId bus, I2cPriority priority, uint16_t DevAddress, uint32_t Trials)
 { 
-  return (HAL_I2C_IsDeviceReady(i2c_handler, DevAddress, Trials, 1000));
-}
-
-/**
-  * @brief  Manages error callback by re-initializing I2C.
-  * @param  i2c_handler : I2C handler
-  * @param  Addr: I2C Address
-  * @retval None
-  */
-static void I2Cx_Error(I2C_HandleTypeDef *i2c_handler, uint8_t Addr)
-{
-  /* De-initialize the I2C communication bus */
-  HAL_I2C_DeInit(i2c_handler);
-  
-  /* Re-Initialize the I2C communication bus */
-  I2Cx_Init(i2c_handler);
+  return i2cBusProbe(bus, priority, DevAddress, Trials);
 }
 
 /*******************************************************************************
@@ -661,7 +521,7 @@ static void I2Cx_Error(I2C_HandleTypeDef *i2c_handler, uint8_t Addr)
   */
 void AUDIO_IO_Init(void) 
 {
-  I2Cx_Init(&hI2cAudioHandler);
+  I2Cx_Init(I2C_BUS_AUDIO);
 }
 
 /**
@@ -687,7 +547,7 @@ void AUDIO_IO_Write(uint8_t Addr, uint16_t Reg, uint16_t Value)
   
   Value |= ((uint16_t)(tmp << 8)& 0xFF00);
   
-  I2Cx_WriteMultiple(&hI2cAudioHandler, Addr, Reg, I2C_MEMADD_SIZE_16BIT,(uint8_t*)&Value, 2);
+  I2Cx_WriteMultiple(I2C_BUS_AUDIO, I2C_PRIORITY_CONTROL, Addr, Reg, I2C_MEMADD_SIZE_16BIT,(uint8_t*)&Value, 2);
 }
 
 /**
@@ -700,7 +560,7 @@ uint16_t AUDIO_IO_Read(uint8_t Addr, uint16_t Reg)
 {
   uint16_t read_value = 0, tmp = 0;
   
-  I2Cx_ReadMultiple(&hI2cAudioHandler, Addr, Reg, I2C_MEMADD_SIZE_16BIT, (uint8_t*)&read_value, 2);
+  I2Cx_ReadMultiple(I2C_BUS_AUDIO, I2C_PRIORITY_CONTROL, Addr, Reg, I2C_MEMADD_SIZE_16BIT, (uint8_t*)&read_value, 2);
   
   tmp = ((uint16_t)(read_value >> 8) & 0x00FF);
   
@@ -718,7 +578,7 @@ uint16_t AUDIO_IO_Read(uint8_t Addr, uint16_t Reg)
   */
 void AUDIO_IO_Delay(uint32_t Delay)
 {
-  HAL_Delay(Delay);
+  i2cBusDelay(Delay);
 }
 
 /********************************* LINK CAMERA ********************************/
@@ -729,7 +589,7 @@ void AUDIO_IO_Delay(uint32_t Delay)
   */
 void CAMERA_IO_Init(void) 
 {
-  I2Cx_Init(&hI2cExtHandler);
+  I2Cx_Init(I2C_BUS_EXT);
 }
 
 /**
@@ -741,7 +601,7 @@ void CAMERA_IO_Init(void)
   */
 void CAMERA_IO_Write(uint8_t Addr, uint8_t Reg, uint8_t Value)
 {
-  I2Cx_WriteMultiple(&hI2cExtHandler, Addr, (uint16_t)Reg, I2C_MEMADD_SIZE_8BIT,(uint8_t*)&Value, 1);
+  I2Cx_WriteMultiple(I2C_BUS_EXT, I2C_PRIORITY_CONTROL, Addr, (uint16_t)Reg, I2C_MEMADD_SIZE_8BIT,(uint8_t*)&Value, 1);
 }
 
 /**
@@ -754,7 +614,7 @@ uint8_t CAMERA_IO_Read(uint8_t Addr, uint8_t Reg)
 {
   uint8_t read_value = 0;
 
-  I2Cx_ReadMultiple(&hI2cExtHandler, Addr, Reg, I2C_MEMADD_SIZE_8BIT, (uint8_t*)&read_value, 1);
+  I2Cx_ReadMultiple(I2C_BUS_EXT, I2C_PRIORITY_CONTROL, Addr, Reg, I2C_MEMADD_SIZE_8BIT, (uint8_t*)&read_value, 1);
 
   return read_value;
 }
@@ -766,7 +626,7 @@ uint8_t CAMERA_IO_Read(uint8_t Addr, uint8_t Reg)
   */
 void CAMERA_Delay(uint32_t Delay)
 {
-  HAL_Delay(Delay);
+  i2cBusDelay(Delay);
 }
 
 /******************************** LINK I2C EEPROM *****************************/
@@ -777,7 +637,7 @@ void CAMERA_Delay(uint32_t Delay)
   */
 void EEPROM_IO_Init(void)
 {
-  I2Cx_Init(&hI2cExtHandler);
+  I2Cx_Init(I2C_BUS_EXT);
 }
 
 /**
@@ -790,7 +650,7 @@ void EEPROM_IO_Init(void)
   */
 HAL_StatusTypeDef EEPROM_IO_WriteData(uint16_t DevAddress, uint16_t MemAddress, uint8_t* pBuffer, uint32_t BufferSize)
 {
-  return (I2Cx_WriteMultiple(&hI2cExtHandler, DevAddress, MemAddress, I2C_MEMADD_SIZE_16BIT, pBuffer, BufferSize));
+  return (I2Cx_WriteMultiple(I2C_BUS_EXT, I2C_PRIORITY_STORAGE, DevAddress, MemAddress, I2C_MEMADD_SIZE_16BIT, pBuffer, BufferSize));
 }
 
 /**
@@ -803,7 +663,7 @@ HAL_StatusTypeDef EEPROM_IO_WriteData(uint16_t DevAddress, uint16_t MemAddress,
   */
 HAL_StatusTypeDef EEPROM_IO_ReadData(uint16_t DevAddress, uint16_t MemAddress, uint8_t* pBuffer, uint32_t BufferSize)
 {
-  return (I2Cx_ReadMultiple(&hI2cExtHandler, DevAddress, MemAddress, I2C_MEMADD_SIZE_16BIT, pBuffer, BufferSize));
+  return (I2Cx_ReadMultiple(I2C_BUS_EXT, I2C_PRIORITY_STORAGE, DevAddress, MemAddress, I2C_MEMADD_SIZE_16BIT, pBuffer, BufferSize));
 }
 
 /**
@@ -815,7 +675,7 @@ HAL_StatusTypeDef EEPROM_IO_ReadData(uint16_t DevAddress, uint16_t MemAddress, u
   */
 HAL_StatusTypeDef EEPROM_IO_IsDeviceReady(uint16_t DevAddress, uint32_t Trials)
 { 
-  return (I2Cx_IsDeviceReady(&hI2cExtHandler, DevAddress, Trials));
+  return (I2Cx_IsDeviceReady(I2C_BUS_EXT, I2C_PRIORITY_STORAGE, DevAddress, Trials));
 }
 
 /********************************* LINK TOUCHSCREEN *********************************/
@@ -826,7 +686,7 @@ HAL_StatusTypeDef EEPROM_IO_IsDeviceReady(uint16_t DevAddress, uint32_t Trials)
   */
 void TS_IO_Init(void)
 {
-  I2Cx_Init(&hI2cAudioHandler);
+  I2Cx_Init(I2C_BUS_AUDIO);
 }
 
 /**
@@ -838,7 +698,7 @@ void TS_IO_Init(void)
   */
 void TS_IO_Write(uint8_t Addr, uint8_t Reg, uint8_t Value)
 {
-  I2Cx_WriteMultiple(&hI2cAudioHandler, Addr, (uint16_t)Reg, I2C_MEMADD_SIZE_8BIT,(uint8_t*)&Value, 1);
+  I2Cx_WriteMultiple(I2C_BUS_AUDIO, I2C_PRIORITY_INPUT, Addr, (uint16_t)Reg, I2C_MEMADD_SIZE_8BIT,(uint8_t*)&Value, 1);
 }
 
 /**
@@ -851,7 +711,7 @@ uint8_t TS_IO_Read(uint8_t Addr, uint8_t Reg)
 {
   uint8_t read_value = 0;
 
-  I2Cx_ReadMultiple(&hI2cAudioHandler, Addr, Reg, I2C_MEMADD_SIZE_8BIT, (uint8_t*)&read_value, 1);
+  I2Cx_ReadMultiple(I2C_BUS_AUDIO, I2C_PRIORITY_INPUT, Addr, Reg, I2C_MEMADD_SIZE_8BIT, (uint8_t*)&read_value, 1);
 
   return read_value;
 }
@@ -863,7 +723,7 @@ uint8_t TS_IO_Read(uint8_t Addr, uint8_t Reg)
   */
 void TS_IO_Delay(uint32_t Delay)
 {
-  HAL_Delay(Delay);
+  i2cBusDelay(Delay);
 }
 
 /**
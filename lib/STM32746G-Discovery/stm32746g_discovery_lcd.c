@@ -134,6 +134,7 @@ static void DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *c);
 static void FillTriangle(uint16_t x1, uint16_t x2, uint16_t x3, uint16_t y1, uint16_t y2, uint16_t y3);
 static void LL_FillBuffer(uint32_t LayerIndex, void *pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLine, uint32_t ColorIndex);
 static void LL_ConvertLineToARGB8888(void * pSrc, void *pDst, uint32_t xSize, uint32_t ColorMode);
+static void LL_TransferComplete(DMA2D_HandleTypeDef *hdma2d);
 /**
   * @}
   */ 
@@ -331,6 +332,44 @@ void BSP_LCD_LayerRgb565Init(uint16_t LayerIndex, uint32_t FB_Address)
   DrawProp[LayerIndex].TextColor = LCD_COLOR_BLACK; 
 }
 
+/**
+  * @brief  Initializes the LCD layer in ARGB8888 format to show a small image in a window.
+  * @param  LayerIndex: Layer foreground or background
+  * @param  FB_Address: Image buffer, Width x Height pixels
+  * @param  Xpos: Window X position
+  * @param  Ypos: Window Y position
+  * @param  Width: Image and window width
+  * @param  Height: Image and window height
+  * @retval None
+  */
+void BSP_LCD_LayerWindowInit(uint16_t LayerIndex, uint32_t FB_Address, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+  LCD_LayerCfgTypeDef  layer_cfg;
+
+  /* Layer Init */
+  layer_cfg.WindowX0 = Xpos;
+  layer_cfg.WindowX1 = Xpos + Width;
+  layer_cfg.WindowY0 = Ypos;
+  layer_cfg.WindowY1 = Ypos + Height;
+  layer_cfg.PixelFormat = LTDC_PIXEL_FORMAT_ARGB8888;
+  layer_cfg.FBStartAdress = FB_Address;
+  layer_cfg.Alpha = 255;
+  layer_cfg.Alpha0 = 0;
+  layer_cfg.Backcolor.Blue = 0;
+  layer_cfg.Backcolor.Green = 0;
+  layer_cfg.Backcolor.Red = 0;
+  layer_cfg.BlendingFactor1 = LTDC_BLENDING_FACTOR1_PAxCA;
+  layer_cfg.BlendingFactor2 = LTDC_BLENDING_FACTOR2_PAxCA;
+  layer_cfg.ImageWidth = Width;
+  layer_cfg.ImageHeight = Height;
+
+  HAL_LTDC_ConfigLayer(&hLtdcHandler, &layer_cfg, LayerIndex);
+
+  DrawProp[LayerIndex].BackColor = LCD_COLOR_WHITE;
+  DrawProp[LayerIndex].pFont     = &Font24;
+  DrawProp[LayerIndex].TextColor = LCD_COLOR_BLACK;
+}
+
 /**
   * @brief  Selects the LCD Layer.
   * @param  LayerIndex: Layer foreground or background
@@ -1246,6 +1285,103 @@ void BSP_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius)
   while (y <= 0);
 }
 
+/**
+  * @brief  Copies a rectangle of pixels into a layer frame buffer using DMA2D
+  *         in interrupt mode. BSP_LCD_DMA2D_TransferCpltCallback() is called
+  *         from BSP_LCD_DMA2D_IRQHandler() once the transfer is complete.
+  * @param  LayerIndex: Layer foreground or background
+  * @param  pSrc: Pointer to the source pixels, in the layer pixel format and
+  *         without padding between lines
+  * @param  Xpos: X position in the layer
+  * @param  Ypos: Y position in the layer
+  * @param  Width: Rectangle width
+  * @param  Height: Rectangle height
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_CopyBuffer_IT(uint32_t LayerIndex, void *pSrc, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+  uint32_t bytes_per_pixel = 0;
+  uint32_t address = 0;
+
+  if(hLtdcHandler.LayerCfg[LayerIndex].PixelFormat == LTDC_PIXEL_FORMAT_RGB565)
+  { /* RGB565 format */
+    hDma2dHandler.Init.ColorMode             = DMA2D_RGB565;
+    hDma2dHandler.LayerCfg[1].InputColorMode = DMA2D_INPUT_RGB565;
+    bytes_per_pixel = 2;
+  }
+  else
+  { /* ARGB8888 format */
+    hDma2dHandler.Init.ColorMode             = DMA2D_ARGB8888;
+    hDma2dHandler.LayerCfg[1].InputColorMode = DMA2D_INPUT_ARGB8888;
+    bytes_per_pixel = 4;
+  }
+  address = hLtdcHandler.LayerCfg[LayerIndex].FBStartAdress + \
+            bytes_per_pixel * (Ypos * hLtdcHandler.LayerCfg[LayerIndex].ImageWidth + Xpos);
+
+  /* Memory to memory mode, the source already has the layer pixel format */
+  hDma2dHandler.Init.Mode         = DMA2D_M2M;
+  hDma2dHandler.Init.OutputOffset = hLtdcHandler.LayerCfg[LayerIndex].ImageWidth - Width;
+
+  /* Foreground Configuration */
+  hDma2dHandler.LayerCfg[1].AlphaMode = DMA2D_NO_MODIF_ALPHA;
+  hDma2dHandler.LayerCfg[1].InputAlpha = 0xFF;
+  hDma2dHandler.LayerCfg[1].InputOffset = 0;
+
+  hDma2dHandler.Instance = DMA2D;
+
+  /* DMA2D Initialization */
+  if(HAL_DMA2D_Init(&hDma2dHandler) != HAL_OK)
+  {
+    return LCD_ERROR;
+  }
+  if(HAL_DMA2D_ConfigLayer(&hDma2dHandler, 1) != HAL_OK)
+  {
+    return LCD_ERROR;
+  }
+
+  hDma2dHandler.XferCpltCallback = LL_TransferComplete;
+
+  if(HAL_DMA2D_Start_IT(&hDma2dHandler, (uint32_t)pSrc, address, Width, Height) != HAL_OK)
+  {
+    return LCD_ERROR;
+  }
+  return LCD_OK;
+}
+
+/**
+  * @brief  Handles the DMA2D interrupt request.
+  * @note   To be called from the application DMA2D_IRQHandler().
+  * @retval None
+  */
+void BSP_LCD_DMA2D_IRQHandler(void)
+{
+  HAL_DMA2D_IRQHandler(&hDma2dHandler);
+}
+
+/**
+  * @brief  Handles the LTDC interrupt request.
+  * @note   To be called from the application LTDC_IRQHandler(). A reload
+  *         requested with BSP_LCD_Reload(LCD_RELOAD_VERTICAL_BLANKING) then
+  *         ends in HAL_LTDC_ReloadEventCallback().
+  * @retval None
+  */
+void BSP_LCD_LTDC_IRQHandler(void)
+{
+  HAL_LTDC_IRQHandler(&hLtdcHandler);
+}
+
+/**
+  * @brief  DMA2D transfer complete callback, called from interrupt context.
+  * @note   This function is called when a transfer started with
+  *         BSP_LCD_CopyBuffer_IT() is complete.
+  * @retval None
+  */
+__weak void BSP_LCD_DMA2D_TransferCpltCallback(void)
+{
+  /* This function should be implemented by the user application.
+     It is called into this driver when the current DMA2D transfer is complete. */
+}
+
 /**
   * @brief  Enables the display.
   * @retval None
@@ -1283,6 +1419,14 @@ __weak void BSP_LCD_MspInit(LTDC_HandleTypeDef *hltdc, void *Params)
   /* Enable the LTDC and DMA2D clocks */
   __HAL_RCC_LTDC_CLK_ENABLE();
   __HAL_RCC_DMA2D_CLK_ENABLE();
+
+  /* Set the DMA2D interrupt priority, used by BSP_LCD_CopyBuffer_IT() */
+  HAL_NVIC_SetPriority(DMA2D_IRQn, 0x0F, 0);
+  HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+
+  /* Set the LTDC interrupt priority, used by the vertical blanking reload */
+  HAL_NVIC_SetPriority(LTDC_IRQn, 0x0F, 0);
+  HAL_NVIC_EnableIRQ(LTDC_IRQn);
   
   /* Enable GPIOs clock */
   __HAL_RCC_GPIOE_CLK_ENABLE();
@@ -1355,6 +1499,10 @@ __weak void BSP_LCD_MspDeInit(LTDC_HandleTypeDef *hltdc, void *Params)
   /* Disable LTDC block */
   __HAL_LTDC_DISABLE(hltdc);
 
+  /* Disable the DMA2D and LTDC interrupts */
+  HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+  HAL_NVIC_DisableIRQ(LTDC_IRQn);
+
   /* LTDC Pins deactivation */
 
   /* GPIOE deactivation */
@@ -1592,6 +1740,16 @@ static void LL_FillBuffer(uint32_t LayerIndex, void *pDst, uint32_t xSize, uint3
   } 
 }
 
+/**
+  * @brief  DMA2D transfer complete callback, forwards to the BSP callback.
+  * @param  hdma2d: DMA2D handle
+  * @retval None
+  */
+static void LL_TransferComplete(DMA2D_HandleTypeDef *hdma2d)
+{
+  BSP_LCD_DMA2D_TransferCpltCallback();
+}
+
 /**
   * @brief  Converts a line to an ARGB8888 pixel format.
   * @param  pSrc: Pointer to source buffer
@@ -172,6 +172,7 @@ void     BSP_LCD_SetYSize(uint32_t imageHeightPixels);
 /* Functions using the LTDC controller */
 void     BSP_LCD_LayerDefaultInit(uint16_t LayerIndex, uint32_t FrameBuffer);
 void     BSP_LCD_LayerRgb565Init(uint16_t LayerIndex, uint32_t FB_Address);
+void     BSP_LCD_LayerWindowInit(uint16_t LayerIndex, uint32_t FB_Address, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
 void     BSP_LCD_SetTransparency(uint32_t LayerIndex, uint8_t Transparency);
 void     BSP_LCD_SetTransparency_NoReload(uint32_t LayerIndex, uint8_t Transparency);
 void     BSP_LCD_SetLayerAddress(uint32_t LayerIndex, uint32_t Address);
@@ -186,6 +187,7 @@ void     BSP_LCD_SelectLayer(uint32_t LayerIndex);
 void     BSP_LCD_SetLayerVisible(uint32_t LayerIndex, FunctionalState State);
 void     BSP_LCD_SetLayerVisible_NoReload(uint32_t LayerIndex, FunctionalState State);
 void     BSP_LCD_Reload(uint32_t ReloadType);
+void     BSP_LCD_LTDC_IRQHandler(void);
 
 void     BSP_LCD_SetTextColor(uint32_t Color);
 uint32_t BSP_LCD_GetTextColor(void);
@@ -216,6 +218,11 @@ void     BSP_LCD_FillCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius);
 void     BSP_LCD_FillPolygon(pPoint Points, uint16_t PointCount);
 void     BSP_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius);
 
+/* Functions using the DMA2D controller in interrupt mode */
+uint8_t  BSP_LCD_CopyBuffer_IT(uint32_t LayerIndex, void *pSrc, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+void     BSP_LCD_DMA2D_IRQHandler(void);
+void     BSP_LCD_DMA2D_TransferCpltCallback(void);
+
 void     BSP_LCD_DisplayOff(void);
 void     BSP_LCD_DisplayOn(void);
 
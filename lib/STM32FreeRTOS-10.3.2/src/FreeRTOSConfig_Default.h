@@ -120,12 +120,16 @@ extern char _Min_Stack_Size; /* Defined in the linker script */
 #define configIDLE_SHOULD_YIELD           1
 #define configUSE_MUTEXES                 1
 #define configQUEUE_REGISTRY_SIZE         8
+#ifndef configCHECK_FOR_STACK_OVERFLOW
 #define configCHECK_FOR_STACK_OVERFLOW    0
+#endif
 #define configUSE_RECURSIVE_MUTEXES       1
 #define configUSE_MALLOC_FAILED_HOOK      0
 #define configUSE_APPLICATION_TASK_TAG    0
 #define configUSE_COUNTING_SEMAPHORES     1
+#ifndef configGENERATE_RUN_TIME_STATS
 #define configGENERATE_RUN_TIME_STATS     0
+#endif
 /*
  * If configUSE_NEWLIB_REENTRANT is set to 1 then a newlib reent structure
  * will be allocated for each created task.
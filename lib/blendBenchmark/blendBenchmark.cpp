@@ -0,0 +1,330 @@
+#include "blendBenchmark.h"
+
+#if BLEND_BENCHMARK
+
+#include <Arduino.h>
+#include <string.h>
+#include "lvgl.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+
+#define PIXEL_COUNT (BLEND_BENCHMARK_WIDTH * BLEND_BENCHMARK_HEIGHT)
+
+// The fill color of every case
+#define FILL_COLOR 0x3A7FD5
+
+struct BlendCase
+{
+    const char *name;
+    lv_color_format_t dest;
+    lv_color_format_t src; // LV_COLOR_FORMAT_UNKNOWN: fill with FILL_COLOR
+    bool masked;
+    lv_opa_t opa;
+};
+
+static const BlendCase cases[] = {
+    {"solid fill", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, false, LV_OPA_COVER},
+    {"opa fill", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, false, LV_OPA_50},
+    {"masked fill", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, true, LV_OPA_COVER},
+    {"masked opa fill", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, true, LV_OPA_50},
+    {"rgb565 image opa", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565, false, LV_OPA_50},
+    {"rgb565 image masked", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565, true, LV_OPA_COVER},
+    {"argb8888 image", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, false, LV_OPA_COVER},
+    {"argb8888 image opa", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, false, LV_OPA_50},
+    {"argb8888 image masked", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, true, LV_OPA_COVER},
+    {"solid fill", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, false, LV_OPA_COVER},
+    {"opa fill", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, false, LV_OPA_50},
+    {"masked fill", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, true, LV_OPA_COVER},
+    {"masked opa fill", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, true, LV_OPA_50},
+    {"argb8888 image", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, false, LV_OPA_COVER},
+    {"argb8888 image opa", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, false, LV_OPA_50},
+    {"argb8888 image masked", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, true, LV_OPA_COVER},
+};
+
+// Word arrays so that both pixel sizes are aligned. The RGB565 cases use the first half of them.
+static uint32_t background[PIXEL_COUNT];
+static uint32_t dest[PIXEL_COUNT];
+static uint32_t expected[PIXEL_COUNT];
+static uint32_t src[PIXEL_COUNT];
+static uint8_t mask[PIXEL_COUNT];
+
+static uint32_t argb(uint32_t rgb, uint32_t alpha)
+{
+    return (rgb & 0x00FFFFFF) | (alpha << 24);
+}
+
+// Mostly the limits, where the loops take their shortcuts
+static uint8_t randomOpa(void)
+{
+    static const uint8_t edges[] = {0, 1, 2, 3, 4, 251, 252, 253, 254, 255};
+    switch (random(4))
+    {
+    case 0:
+        return 0;
+    case 1:
+        return 255;
+    case 2:
+        return edges[random(sizeof(edges))];
+    default:
+        return random(256);
+    }
+}
+
+// Random content, with runs of equal mask values to reach the 4 pixel shortcuts
+static void randomContent(void)
+{
+    for (int i = 0; i < PIXEL_COUNT; i++)
+    {
+        background[i] = argb(random(0x1000000), randomOpa());
+        src[i] = argb(random(0x1000000), randomOpa());
+    }
+
+    int i = 0;
+    while (i < PIXEL_COUNT)
+    {
+        uint8_t value = randomOpa();
+        for (int run = random(1, 9); run > 0 && i < PIXEL_COUNT; run--)
+        {
+            mask[i++] = value;
+        }
+    }
+}
+
+// What the loops see most: an opaque background, a shape whose mask is transparent on the left,
+// anti-aliased on 8 pixels and opaque on the right, an image with transparent and fading edges
+static void typicalContent(void)
+{
+    for (int y = 0; y < BLEND_BENCHMARK_HEIGHT; y++)
+    {
+        for (int x = 0; x < BLEND_BENCHMARK_WIDTH; x++)
+        {
+            int edge = x - BLEND_BENCHMARK_WIDTH / 4;
+            uint8_t value = edge < 0 ? 0 : edge < 8 ? edge * 32 + 16 : 255;
+            int i = y * BLEND_BENCHMARK_WIDTH + x;
+            mask[i] = value;
+            background[i] = argb(0x102030 + i * 0x010203, 255);
+            src[i] = argb(0xC08040 + i * 0x030201, mask[y * BLEND_BENCHMARK_WIDTH + BLEND_BENCHMARK_WIDTH - 1 - x]);
+        }
+    }
+}
+
+// lv_color_24_16_mix() of the C loops
+static uint16_t referenceMix24To16(uint32_t c, uint16_t bg, uint32_t mix)
+{
+    if (mix == 0)
+    {
+        return bg;
+    }
+    uint32_t r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
+    if (mix == 255)
+    {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+    uint32_t inv = 255 - mix;
+    return ((((r >> 3) * mix + ((bg >> 11) & 0x1F) * inv) >> 8) << 11) |
+           ((((g >> 2) * mix + ((bg >> 5) & 0x3F) * inv) >> 8) << 5) |
+           (((b >> 3) * mix + (bg & 0x1F) * inv) >> 8);
+}
+
+// lv_color_32_32_mix() of the C loops, without its cache
+static uint32_t referenceMix32(uint32_t fg, uint32_t bg)
+{
+    lv_color32_t f, b, res;
+    memcpy(&f, &fg, 4);
+    memcpy(&b, &bg, 4);
+    if (f.alpha >= LV_OPA_MAX || b.alpha <= LV_OPA_MIN)
+    {
+        return fg;
+    }
+    if (f.alpha <= LV_OPA_MIN)
+    {
+        return bg;
+    }
+    if (b.alpha == 255)
+    {
+        res = lv_color_mix32(f, b);
+    }
+    else
+    {
+        uint8_t resAlpha = 255 - LV_OPA_MIX2(255 - f.alpha, 255 - b.alpha);
+        f.alpha = (uint32_t)f.alpha * 255 / resAlpha;
+        res = lv_color_mix32(f, b);
+        res.alpha = resAlpha;
+    }
+    uint32_t result;
+    memcpy(&result, &res, 4);
+    return result;
+}
+
+// The ratio of a fill color or an RGB565 pixel
+static uint32_t mixRatio(const BlendCase &c, int i)
+{
+    if (!c.masked)
+    {
+        return c.opa >= LV_OPA_MAX ? 255 : c.opa;
+    }
+    return c.opa >= LV_OPA_MAX ? mask[i] : LV_OPA_MIX2(mask[i], c.opa);
+}
+
+// The ratio of an ARGB8888 pixel
+static uint32_t alphaRatio(const BlendCase &c, int i)
+{
+    uint32_t alpha = src[i] >> 24;
+    if (!c.masked)
+    {
+        return c.opa >= LV_OPA_MAX ? alpha : LV_OPA_MIX2(alpha, c.opa);
+    }
+    return c.opa >= LV_OPA_MAX ? LV_OPA_MIX2(alpha, mask[i]) : LV_OPA_MIX3(alpha, mask[i], c.opa);
+}
+
+// The result of the case on `background`, pixel by pixel
+static void computeExpected(const BlendCase &c)
+{
+    uint16_t color16 = lv_color_to_u16(lv_color_hex(FILL_COLOR));
+    uint16_t *bg16 = (uint16_t *)background;
+    uint16_t *expected16 = (uint16_t *)expected;
+    const uint16_t *src16 = (const uint16_t *)src;
+
+    for (int i = 0; i < PIXEL_COUNT; i++)
+    {
+        if (c.dest == LV_COLOR_FORMAT_RGB565)
+        {
+            if (c.src == LV_COLOR_FORMAT_UNKNOWN)
+            {
+                expected16[i] = lv_color_16_16_mix(color16, bg16[i], mixRatio(c, i));
+            }
+            else if (c.src == LV_COLOR_FORMAT_RGB565)
+            {
+                expected16[i] = lv_color_16_16_mix(src16[i], bg16[i], mixRatio(c, i));
+            }
+            else
+            {
+                expected16[i] = referenceMix24To16(src[i], bg16[i], alphaRatio(c, i));
+            }
+        }
+        else
+        {
+            if (c.src == LV_COLOR_FORMAT_UNKNOWN)
+            {
+                expected[i] = referenceMix32(argb(FILL_COLOR, mixRatio(c, i)), background[i]);
+            }
+            else
+            {
+                expected[i] = referenceMix32(argb(src[i], alphaRatio(c, i)), background[i]);
+            }
+        }
+    }
+}
+
+// Blends the case on `dest` with LVGL's loops, the DSP back-end or the C ones
+static void blend(const BlendCase &c)
+{
+    uint32_t pixelSize = lv_color_format_get_size(c.dest);
+
+    if (c.src == LV_COLOR_FORMAT_UNKNOWN)
+    {
+        lv_draw_sw_blend_fill_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.dest_buf = dest;
+        dsc.dest_w = BLEND_BENCHMARK_WIDTH;
+        dsc.dest_h = BLEND_BENCHMARK_HEIGHT;
+        dsc.dest_stride = BLEND_BENCHMARK_WIDTH * pixelSize;
+        dsc.mask_buf = c.masked ? mask : NULL;
+        dsc.mask_stride = BLEND_BENCHMARK_WIDTH;
+        dsc.color = lv_color_hex(FILL_COLOR);
+        dsc.opa = c.opa;
+        if (c.dest == LV_COLOR_FORMAT_RGB565)
+        {
+            lv_draw_sw_blend_color_to_rgb565(&dsc);
+        }
+        else
+        {
+            lv_draw_sw_blend_color_to_argb8888(&dsc);
+        }
+    }
+    else
+    {
+        lv_draw_sw_blend_image_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.dest_buf = dest;
+        dsc.dest_w = BLEND_BENCHMARK_WIDTH;
+        dsc.dest_h = BLEND_BENCHMARK_HEIGHT;
+        dsc.dest_stride = BLEND_BENCHMARK_WIDTH * pixelSize;
+        dsc.mask_buf = c.masked ? mask : NULL;
+        dsc.mask_stride = BLEND_BENCHMARK_WIDTH;
+        dsc.src_buf = src;
+        dsc.src_stride = BLEND_BENCHMARK_WIDTH * lv_color_format_get_size(c.src);
+        dsc.src_color_format = c.src;
+        dsc.opa = c.opa;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+        if (c.dest == LV_COLOR_FORMAT_RGB565)
+        {
+            lv_draw_sw_blend_image_to_rgb565(&dsc);
+        }
+        else
+        {
+            lv_draw_sw_blend_image_to_argb8888(&dsc);
+        }
+    }
+}
+
+static int countMismatches(const BlendCase &c)
+{
+    uint32_t pixelSize = lv_color_format_get_size(c.dest);
+    int mismatches = 0;
+    for (int i = 0; i < PIXEL_COUNT; i++)
+    {
+        mismatches += memcmp((uint8_t *)dest + i * pixelSize, (uint8_t *)expected + i * pixelSize, pixelSize) != 0;
+    }
+    return mismatches;
+}
+
+void blendBenchmark(void)
+{
+    // The Cortex-M7 DWT registers are locked after reset
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_ARMV7EM
+    Serial.println("blend: ARMv7E-M DSP loops");
+#else
+    Serial.println("blend: C loops");
+#endif
+    Serial.printf("%d x %d pixels, %d runs\n", BLEND_BENCHMARK_WIDTH, BLEND_BENCHMARK_HEIGHT, BLEND_BENCHMARK_RUNS);
+
+    for (size_t n = 0; n < sizeof(cases) / sizeof(cases[0]); n++)
+    {
+        const BlendCase &c = cases[n];
+
+        // Every shortcut and rounding first, on random pixels
+        int mismatches = 0;
+        for (int pass = 0; pass < 10; pass++)
+        {
+            randomContent();
+            computeExpected(c);
+            memcpy(dest, background, sizeof(dest));
+            blend(c);
+            mismatches += countMismatches(c);
+        }
+
+        typicalContent();
+        uint32_t cycles = 0;
+        for (int run = 0; run < BLEND_BENCHMARK_RUNS; run++)
+        {
+            memcpy(dest, background, sizeof(dest));
+            uint32_t start = DWT->CYCCNT;
+            blend(c);
+            cycles += DWT->CYCCNT - start;
+        }
+
+        // In tenths of a cycle
+        uint32_t perPixel = (uint64_t)cycles * 10 / ((uint64_t)PIXEL_COUNT * BLEND_BENCHMARK_RUNS);
+        const char *destName = c.dest == LV_COLOR_FORMAT_RGB565 ? "rgb565" : "argb8888";
+        Serial.printf("%-8s %-22s %3lu.%lu cycles/px, %d mismatches\n", destName, c.name, perPixel / 10, perPixel % 10,
+                      mismatches);
+    }
+}
+
+#endif // BLEND_BENCHMARK
@@ -0,0 +1,33 @@
+#ifndef BLEND_BENCHMARK_H
+#define BLEND_BENCHMARK_H
+
+// Blend benchmark mode (env:disco_f746ng_blend_bench): checks the LVGL software blend loops against
+// scalar references and prints their cost in CPU cycles per pixel, to compare the ARMv7E-M DSP
+// back-end (LV_DRAW_SW_ASM_ARMV7EM) with the C loops (env:disco_f746ng_blend_bench_c).
+#ifndef BLEND_BENCHMARK
+#define BLEND_BENCHMARK 0
+#endif
+
+// Size of the blended area, in pixels. The buffers are static, 4 of them with 4 bytes per pixel.
+#ifndef BLEND_BENCHMARK_WIDTH
+#define BLEND_BENCHMARK_WIDTH 128
+#endif
+
+#ifndef BLEND_BENCHMARK_HEIGHT
+#define BLEND_BENCHMARK_HEIGHT 16
+#endif
+
+// Number of timed runs of every case
+#ifndef BLEND_BENCHMARK_RUNS
+#define BLEND_BENCHMARK_RUNS 20
+#endif
+
+#if BLEND_BENCHMARK
+
+// Prints the mismatches and the cycles per pixel of the fills and image blends on Serial.
+// It doesn't draw on the display. Call it from mySetup(): the scheduler doesn't run yet, no task interrupts it.
+void blendBenchmark(void);
+
+#endif
+
+#endif // BLEND_BENCHMARK_H
@@ -0,0 +1,330 @@
+#include "gamePhysics.h"
+
+static int gridCol(const PhysicsWorld *world, float x)
+{
+    // The bodies outside the playfield are kept in the border cells
+    int col = (int)(x * world->invCellSize);
+    return col < 0 ? 0 : (col >= world->gridCols ? world->gridCols - 1 : col);
+}
+
+static int gridRow(const PhysicsWorld *world, float y)
+{
+    int row = (int)(y * world->invCellSize);
+    return row < 0 ? 0 : (row >= world->gridRows ? world->gridRows - 1 : row);
+}
+
+static int gridCell(const PhysicsWorld *world, int i)
+{
+    return gridRow(world, world->y[i]) * world->gridCols + gridCol(world, world->x[i]);
+}
+
+static void gridInsert(PhysicsWorld *world, int i, int cell)
+{
+    int head = world->cellHead[cell];
+
+    world->bodyCell[i] = cell;
+    world->cellPrev[i] = -1;
+    world->cellNext[i] = head;
+    if (head >= 0)
+    {
+        world->cellPrev[head] = i;
+    }
+    world->cellHead[cell] = i;
+}
+
+static void gridRemove(PhysicsWorld *world, int i)
+{
+    int prev = world->cellPrev[i];
+    int next = world->cellNext[i];
+
+    if (prev >= 0)
+    {
+        world->cellNext[prev] = next;
+    }
+    else
+    {
+        world->cellHead[world->bodyCell[i]] = next;
+    }
+    if (next >= 0)
+    {
+        world->cellPrev[next] = prev;
+    }
+}
+
+void physicsInit(PhysicsWorld *world, float width, float height, float bodySize)
+{
+    world->width = width;
+    world->height = height;
+    world->bodySize = bodySize;
+    world->bodyCollisions = false;
+
+    // Two bodies that overlap are at most one cell apart
+    float cellSize = bodySize;
+    if (cellSize < width / PHYSICS_GRID_MAX_COLS)
+    {
+        cellSize = width / PHYSICS_GRID_MAX_COLS;
+    }
+    if (cellSize < height / PHYSICS_GRID_MAX_ROWS)
+    {
+        cellSize = height / PHYSICS_GRID_MAX_ROWS;
+    }
+
+    world->invCellSize = 1.0f / cellSize;
+    world->gridCols = (int)(width * world->invCellSize) + 1;
+    world->gridRows = (int)(height * world->invCellSize) + 1;
+    if (world->gridCols > PHYSICS_GRID_MAX_COLS)
+    {
+        world->gridCols = PHYSICS_GRID_MAX_COLS;
+    }
+    if (world->gridRows > PHYSICS_GRID_MAX_ROWS)
+    {
+        world->gridRows = PHYSICS_GRID_MAX_ROWS;
+    }
+
+    physicsClear(world);
+}
+
+void physicsClear(PhysicsWorld *world)
+{
+    world->count = 0;
+    world->accumulatorMs = 0;
+
+    for (int c = 0; c < world->gridCols * world->gridRows; c++)
+    {
+        world->cellHead[c] = -1;
+    }
+}
+
+int physicsAdd(PhysicsWorld *world, float x, float y, float dx, float dy)
+{
+    if (world->count >= PHYSICS_MAX_BODIES)
+    {
+        return -1;
+    }
+
+    int i = world->count++;
+    world->x[i] = x;
+    world->y[i] = y;
+    world->dx[i] = dx;
+    world->dy[i] = dy;
+    gridInsert(world, i, gridCell(world, i));
+    return i;
+}
+
+void physicsSetBodyCollisions(PhysicsWorld *world, bool enabled)
+{
+    world->bodyCollisions = enabled;
+}
+
+int physicsAdvance(PhysicsWorld *world, uint32_t elapsedMs)
+{
+    world->accumulatorMs += elapsedMs;
+
+    int steps = 0;
+    while (world->accumulatorMs >= PHYSICS_STEP_MS)
+    {
+        if (steps == PHYSICS_MAX_STEPS_PER_ADVANCE)
+        {
+            // Too late to catch up, slow the simulation down instead of stalling the frame
+            world->accumulatorMs = 0;
+            break;
+        }
+
+        physicsStep(world);
+        world->accumulatorMs -= PHYSICS_STEP_MS;
+        steps++;
+    }
+
+    return steps;
+}
+
+static void collidePair(PhysicsWorld *world, int i, int j)
+{
+    float size = world->bodySize;
+    float distX = world->x[j] - world->x[i];
+    float distY = world->y[j] - world->y[i];
+    float overlapX = size - (distX < 0 ? -distX : distX);
+    float overlapY = size - (distY < 0 ? -distY : distY);
+
+    if (overlapX <= 0 || overlapY <= 0)
+    {
+        return;
+    }
+
+    // Equal masses: swap the velocities along the axis of least penetration,
+    // only if the bodies still move toward each other so they can separate
+    if (overlapX < overlapY)
+    {
+        if ((world->dx[j] - world->dx[i]) * distX < 0)
+        {
+            float dx = world->dx[i];
+            world->dx[i] = world->dx[j];
+            world->dx[j] = dx;
+        }
+    }
+    else
+    {
+        if ((world->dy[j] - world->dy[i]) * distY < 0)
+        {
+            float dy = world->dy[i];
+            world->dy[i] = world->dy[j];
+            world->dy[j] = dy;
+        }
+    }
+}
+
+static void collideBodies(PhysicsWorld *world)
+{
+    // Each pair is tested once: a body against the ones after it in its cell,
+    // then against the cells on the right and the one below
+    static const int neighbourCols[] = {1, 1, 1, 0};
+    static const int neighbourRows[] = {-1, 0, 1, 1};
+
+    for (int row = 0; row < world->gridRows; row++)
+    {
+        for (int col = 0; col < world->gridCols; col++)
+        {
+            for (int i = world->cellHead[row * world->gridCols + col]; i >= 0; i = world->cellNext[i])
+            {
+                for (int j = world->cellNext[i]; j >= 0; j = world->cellNext[j])
+                {
+                    collidePair(world, i, j);
+                }
+
+                for (int n = 0; n < 4; n++)
+                {
+                    int nCol = col + neighbourCols[n];
+                    int nRow = row + neighbourRows[n];
+                    if (nCol >= world->gridCols || nRow < 0 || nRow >= world->gridRows)
+                    {
+                        continue;
+                    }
+
+                    for (int j = world->cellHead[nRow * world->gridCols + nCol]; j >= 0; j = world->cellNext[j])
+                    {
+                        collidePair(world, i, j);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void physicsStep(PhysicsWorld *world)
+{
+    float maxX = world->width - world->bodySize;
+    float maxY = world->height - world->bodySize;
+
+    for (int i = 0; i < world->count; i++)
+    {
+        world->x[i] += world->dx[i];
+        world->y[i] += world->dy[i];
+    }
+
+    // Only bounce bodies moving toward a border: the new ones enter the playfield from outside
+    for (int i = 0; i < world->count; i++)
+    {
+        if ((world->x[i] <= 0 && world->dx[i] < 0) || (world->x[i] >= maxX && world->dx[i] > 0))
+        {
+            world->dx[i] = -world->dx[i];
+        }
+        if ((world->y[i] <= 0 && world->dy[i] < 0) || (world->y[i] >= maxY && world->dy[i] > 0))
+        {
+            world->dy[i] = -world->dy[i];
+        }
+    }
+
+    // A body moves less than a cell per step, most of them stay in the same list
+    for (int i = 0; i < world->count; i++)
+    {
+        int cell = gridCell(world, i);
+        if (cell != world->bodyCell[i])
+        {
+            gridRemove(world, i);
+            gridInsert(world, i, cell);
+        }
+    }
+
+    if (world->bodyCollisions)
+    {
+        collideBodies(world);
+    }
+}
+
+bool physicsCircleHitsBox(float cx, float cy, float r, float x, float y, float w, float h)
+{
+    // Distance from the center to the closest point of the box
+    float closestX = cx < x ? x : (cx > x + w ? x + w : cx);
+    float closestY = cy < y ? y : (cy > y + h ? y + h : cy);
+    float distX = cx - closestX;
+    float distY = cy - closestY;
+
+    return distX * distX + distY * distY < r * r;
+}
+
+int physicsCollideCircle(const PhysicsWorld *world, float cx, float cy, float r)
+{
+    if (world->count < PHYSICS_GRID_MIN_BODIES)
+    {
+        return physicsCollideCircleScan(world, cx, cy, r);
+    }
+
+    return physicsCollideCircleGrid(world, cx, cy, r);
+}
+
+int physicsCollideCircleGrid(const PhysicsWorld *world, float cx, float cy, float r)
+{
+    float size = world->bodySize;
+
+    // Cells holding the top left corner of the bodies that can touch the circle bounding box
+    int col1 = gridCol(world, cx - r - size);
+    int col2 = gridCol(world, cx + r);
+    int row1 = gridRow(world, cy - r - size);
+    int row2 = gridRow(world, cy + r);
+
+    for (int row = row1; row <= row2; row++)
+    {
+        for (int col = col1; col <= col2; col++)
+        {
+            for (int i = world->cellHead[row * world->gridCols + col]; i >= 0; i = world->cellNext[i])
+            {
+                if (physicsCircleHitsBox(cx, cy, r, world->x[i], world->y[i], size, size))
+                {
+                    return i;
+                }
+            }
+        }
+    }
+
+    return -1;
+}
+
+int physicsCollideCircleScan(const PhysicsWorld *world, float cx, float cy, float r)
+{
+    for (int i = 0; i < world->count; i += PHYSICS_BATCH_SIZE)
+    {
+        int count = world->count - i < PHYSICS_BATCH_SIZE ? world->count - i : PHYSICS_BATCH_SIZE;
+        uint32_t hits = physicsCircleHitsBoxes(&world->x[i], &world->y[i], count, world->bodySize, cx, cy, r);
+        if (hits != 0)
+        {
+            return i + __builtin_ctz(hits);
+        }
+    }
+
+    return -1;
+}
+
+int physicsCollideCircleScanScalar(const PhysicsWorld *world, float cx, float cy, float r)
+{
+    float size = world->bodySize;
+
+    for (int i = 0; i < world->count; i++)
+    {
+        if (physicsCircleHitsBox(cx, cy, r, world->x[i], world->y[i], size, size))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
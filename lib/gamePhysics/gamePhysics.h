@@ -0,0 +1,110 @@
+#ifndef GAME_PHYSICS_H
+#define GAME_PHYSICS_H
+
+#include <stdint.h>
+
+// Capacity of a world, can be raised from the build flags
+#ifndef PHYSICS_MAX_BODIES
+#define PHYSICS_MAX_BODIES 256
+#endif
+
+#if PHYSICS_MAX_BODIES > 32767
+#error "The broad phase grid stores body indices on 16 bits"
+#endif
+
+// Duration of one simulation step, the velocities are in pixels per step
+#define PHYSICS_STEP_MS 20
+
+// Limit of steps run by one physicsAdvance() call, the late time is dropped beyond it
+#define PHYSICS_MAX_STEPS_PER_ADVANCE 5
+
+// Maximum size of the broad phase grid. The cells are as large as a body,
+// or larger if the playfield would need more cells than this.
+#define PHYSICS_GRID_MAX_COLS 32
+#define PHYSICS_GRID_MAX_ROWS 16
+
+// Below this number of bodies, testing them all in batches is cheaper than walking the grid
+#define PHYSICS_GRID_MIN_BODIES 64
+
+// Number of bodies tested by one physicsCircleHitsBoxes() call, one bit of the result each
+#define PHYSICS_BATCH_SIZE 32
+
+// Square bodies bouncing in a rectangular playfield, stored as structure of arrays so the
+// integration and collision loops stream through contiguous floats.
+// The active bodies are packed in [0, count).
+struct PhysicsWorld
+{
+    float x[PHYSICS_MAX_BODIES];
+    float y[PHYSICS_MAX_BODIES];
+    float dx[PHYSICS_MAX_BODIES];
+    float dy[PHYSICS_MAX_BODIES];
+    int count;
+
+    float width;
+    float height;
+    float bodySize;
+
+    uint32_t accumulatorMs;
+
+    // Bounce the bodies on each other, not only on the borders
+    bool bodyCollisions;
+
+    // Broad phase: uniform grid with a doubly linked list of bodies per cell, indexed by the
+    // top left corner of each body. A body is only relinked when it moves to another cell.
+    int gridCols;
+    int gridRows;
+    float invCellSize;
+    int16_t cellHead[PHYSICS_GRID_MAX_COLS * PHYSICS_GRID_MAX_ROWS];
+    int16_t cellNext[PHYSICS_MAX_BODIES];
+    int16_t cellPrev[PHYSICS_MAX_BODIES];
+    int16_t bodyCell[PHYSICS_MAX_BODIES];
+};
+
+void physicsInit(PhysicsWorld *world, float width, float height, float bodySize);
+void physicsClear(PhysicsWorld *world);
+
+// Returns the index of the new body, or -1 if the world is full
+int physicsAdd(PhysicsWorld *world, float x, float y, float dx, float dy);
+
+// Runs as many fixed steps as fit in the elapsed time plus the time left over by the previous call.
+// Returns the number of steps run.
+int physicsAdvance(PhysicsWorld *world, uint32_t elapsedMs);
+
+// Moves every body by its velocity and bounces it on the playfield borders,
+// and on the other bodies when enabled
+void physicsStep(PhysicsWorld *world);
+
+void physicsSetBodyCollisions(PhysicsWorld *world, bool enabled);
+
+// Circle against axis-aligned box test
+bool physicsCircleHitsBox(float cx, float cy, float r, float x, float y, float w, float h);
+
+// Tests a circle against up to PHYSICS_BATCH_SIZE square boxes given by their top left corners.
+// Bit i of the result is set if the circle hits box i. Uses physicsCircleHitsBoxesUnrolled() on the
+// Cortex-M7, SSE/AVX on the emulator, and the same computation as physicsCircleHitsBox() otherwise.
+uint32_t physicsCircleHitsBoxes(const float *x, const float *y, int count, float size, float cx, float cy, float r);
+
+// Four branchless tests per iteration for the FPU of the Cortex-M7, built on every target so the host
+// tests can check it
+uint32_t physicsCircleHitsBoxesUnrolled(const float *x, const float *y, int count, float size, float cx, float cy,
+                                        float r);
+
+// Portable version of physicsCircleHitsBoxes(), the optimized ones must return the same masks
+uint32_t physicsCircleHitsBoxesScalar(const float *x, const float *y, int count, float size, float cx, float cy,
+                                      float r);
+
+// Returns the index of a body hit by the circle, or -1.
+// Only the bodies of the grid cells around the circle are tested, unless there are few bodies.
+int physicsCollideCircle(const PhysicsWorld *world, float cx, float cy, float r);
+
+// Same result as physicsCollideCircle() with a batched scan of all the bodies
+int physicsCollideCircleScan(const PhysicsWorld *world, float cx, float cy, float r);
+
+// Same result as physicsCollideCircle(), always walking the grid whatever the number of bodies
+int physicsCollideCircleGrid(const PhysicsWorld *world, float cx, float cy, float r);
+
+// Same result as physicsCollideCircle() with a scan testing the bodies one by one, the reference
+// of the benchmark
+int physicsCollideCircleScanScalar(const PhysicsWorld *world, float cx, float cy, float r);
+
+#endif // GAME_PHYSICS_H
@@ -0,0 +1,121 @@
+#include "gamePhysics.h"
+
+#if defined(__AVX__) || defined(__SSE__)
+#include <immintrin.h>
+#endif
+
+uint32_t physicsCircleHitsBoxesScalar(const float *x, const float *y, int count, float size, float cx, float cy,
+                                      float r)
+{
+    uint32_t hits = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (physicsCircleHitsBox(cx, cy, r, x[i], y[i], size, size))
+        {
+            hits |= 1UL << i;
+        }
+    }
+
+    return hits;
+}
+
+// Branchless test: on the Cortex-M7 the clamps become VMAXNM/VMINNM and the comparison a flag move
+static inline uint32_t hitBit(float x, float y, float size, float cx, float cy, float r2)
+{
+    float distX = cx - __builtin_fminf(__builtin_fmaxf(cx, x), x + size);
+    float distY = cy - __builtin_fminf(__builtin_fmaxf(cy, y), y + size);
+
+    return distX * distX + distY * distY < r2;
+}
+
+// Plain C unrolled for the M7 FPU. It uses no DSP instruction: the DSP SIMD only works on 16-bit
+// integers and the boxes are floats. The dual issue is whatever the compiler schedules from the four
+// independent chains, which let the M7 issue the loads next to the FPU operations instead of stalling
+// on the latency of each one.
+uint32_t physicsCircleHitsBoxesUnrolled(const float *x, const float *y, int count, float size, float cx, float cy,
+                                        float r)
+{
+    float r2 = r * r;
+    uint32_t hits = 0;
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t hit0 = hitBit(x[i], y[i], size, cx, cy, r2);
+        uint32_t hit1 = hitBit(x[i + 1], y[i + 1], size, cx, cy, r2);
+        uint32_t hit2 = hitBit(x[i + 2], y[i + 2], size, cx, cy, r2);
+        uint32_t hit3 = hitBit(x[i + 3], y[i + 3], size, cx, cy, r2);
+        hits |= (hit0 | hit1 << 1 | hit2 << 2 | hit3 << 3) << i;
+    }
+
+    for (; i < count; i++)
+    {
+        hits |= hitBit(x[i], y[i], size, cx, cy, r2) << i;
+    }
+
+    return hits;
+}
+
+#if defined(__ARM_ARCH_7EM__) && defined(__ARM_FP)
+
+uint32_t physicsCircleHitsBoxes(const float *x, const float *y, int count, float size, float cx, float cy, float r)
+{
+    return physicsCircleHitsBoxesUnrolled(x, y, count, size, cx, cy, r);
+}
+
+#elif defined(__AVX__) || defined(__SSE__)
+
+uint32_t physicsCircleHitsBoxes(const float *x, const float *y, int count, float size, float cx, float cy, float r)
+{
+    uint32_t hits = 0;
+    int i = 0;
+
+#if defined(__AVX__)
+    __m256 centerX8 = _mm256_set1_ps(cx);
+    __m256 centerY8 = _mm256_set1_ps(cy);
+    __m256 size8 = _mm256_set1_ps(size);
+    __m256 r28 = _mm256_set1_ps(r * r);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 boxX = _mm256_loadu_ps(&x[i]);
+        __m256 boxY = _mm256_loadu_ps(&y[i]);
+        __m256 distX = _mm256_sub_ps(centerX8, _mm256_min_ps(_mm256_max_ps(centerX8, boxX), _mm256_add_ps(boxX, size8)));
+        __m256 distY = _mm256_sub_ps(centerY8, _mm256_min_ps(_mm256_max_ps(centerY8, boxY), _mm256_add_ps(boxY, size8)));
+        __m256 dist2 = _mm256_add_ps(_mm256_mul_ps(distX, distX), _mm256_mul_ps(distY, distY));
+        hits |= (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(dist2, r28, _CMP_LT_OQ)) << i;
+    }
+#endif
+
+    __m128 centerX4 = _mm_set1_ps(cx);
+    __m128 centerY4 = _mm_set1_ps(cy);
+    __m128 size4 = _mm_set1_ps(size);
+    __m128 r24 = _mm_set1_ps(r * r);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 boxX = _mm_loadu_ps(&x[i]);
+        __m128 boxY = _mm_loadu_ps(&y[i]);
+        __m128 distX = _mm_sub_ps(centerX4, _mm_min_ps(_mm_max_ps(centerX4, boxX), _mm_add_ps(boxX, size4)));
+        __m128 distY = _mm_sub_ps(centerY4, _mm_min_ps(_mm_max_ps(centerY4, boxY), _mm_add_ps(boxY, size4)));
+        __m128 dist2 = _mm_add_ps(_mm_mul_ps(distX, distX), _mm_mul_ps(distY, distY));
+        hits |= (uint32_t)_mm_movemask_ps(_mm_cmplt_ps(dist2, r24)) << i;
+    }
+
+    if (i < count)
+    {
+        hits |= physicsCircleHitsBoxesScalar(&x[i], &y[i], count - i, size, cx, cy, r) << i;
+    }
+
+    return hits;
+}
+
+#else
+
+uint32_t physicsCircleHitsBoxes(const float *x, const float *y, int count, float size, float cx, float cy, float r)
+{
+    return physicsCircleHitsBoxesScalar(x, y, count, size, cx, cy, r);
+}
+
+#endif
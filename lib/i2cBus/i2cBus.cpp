@@ -0,0 +1,395 @@
+#include "i2cBus.h"
+#include <Wire.h>
+#include <string.h>
+#include "STM32FreeRTOS.h"
+
+// The I2C and DMA interrupts wake the bus tasks, they must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY
+#define I2C_BUS_IRQ_PRIO (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1)
+
+// Timeout of the polled transfers and address polls
+#define I2C_BUS_POLL_TIMEOUT_MS 100
+
+// Peripheral resources of a bus, DMA1 requests from the reference manual
+struct I2cBusHardware
+{
+    IRQn_Type evIrq;
+    IRQn_Type erIrq;
+    DMA_Stream_TypeDef *rxStream;
+    DMA_Stream_TypeDef *txStream;
+    uint32_t dmaChannel;
+    IRQn_Type rxIrq;
+    IRQn_Type txIrq;
+};
+
+static const I2cBusHardware hardware[I2C_BUS_COUNT] = {
+    {I2C3_EV_IRQn, I2C3_ER_IRQn, DMA1_Stream2, DMA1_Stream4, DMA_CHANNEL_3, DMA1_Stream2_IRQn, DMA1_Stream4_IRQn},
+    {I2C1_EV_IRQn, I2C1_ER_IRQn, DMA1_Stream0, DMA1_Stream6, DMA_CHANNEL_1, DMA1_Stream0_IRQn, DMA1_Stream6_IRQn},
+};
+
+struct I2cBus
+{
+    bool started;
+    I2C_HandleTypeDef *handle;
+    DMA_HandleTypeDef dmaRx;
+    DMA_HandleTypeDef dmaTx;
+    uint8_t *dmaBuffer;
+
+    QueueHandle_t queues[I2C_PRIORITY_COUNT];
+    TaskHandle_t task;
+    SemaphoreHandle_t doneSemaphore;
+};
+
+static I2cBus buses[I2C_BUS_COUNT];
+static uint8_t dmaBuffers[I2C_BUS_COUNT][I2C_BUS_DMA_BUFFER_SIZE] __attribute__((aligned(32)));
+
+// The Wire library owns the I2C interrupt handlers, so each bus is opened through a TwoWire
+// object and then driven through its HAL handle. The audio bus is not on the Arduino connector.
+static TwoWire audioWire;
+
+static void cleanDCache(const void *addr, uint32_t size)
+{
+    if (SCB->CCR & SCB_CCR_DC_Msk)
+    {
+        SCB_CleanDCache_by_Addr((uint32_t *)addr, (size + 31) & ~31UL);
+    }
+}
+
+static void invalidateDCache(void *addr, uint32_t size)
+{
+    // Only used on the DMA buffers, aligned and sized on cache lines
+    if (SCB->CCR & SCB_CCR_DC_Msk)
+    {
+        SCB_InvalidateDCache_by_Addr((uint32_t *)addr, (size + 31) & ~31UL);
+    }
+}
+
+static void transferDone(I2C_HandleTypeDef *hi2c)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    for (int i = 0; i < I2C_BUS_COUNT; i++)
+    {
+        if (buses[i].handle == hi2c)
+        {
+            xSemaphoreGiveFromISR(buses[i].doneSemaphore, &higherPriorityTaskWoken);
+        }
+    }
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+extern "C" void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    transferDone(hi2c);
+}
+
+extern "C" void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    transferDone(hi2c);
+}
+
+extern "C" void DMA1_Stream0_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&buses[I2C_BUS_EXT].dmaRx);
+}
+
+extern "C" void DMA1_Stream6_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&buses[I2C_BUS_EXT].dmaTx);
+}
+
+extern "C" void DMA1_Stream2_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&buses[I2C_BUS_AUDIO].dmaRx);
+}
+
+extern "C" void DMA1_Stream4_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&buses[I2C_BUS_AUDIO].dmaTx);
+}
+
+static void initDma(DMA_HandleTypeDef *dma, DMA_Stream_TypeDef *stream, uint32_t channel, uint32_t direction,
+                    IRQn_Type irq)
+{
+    dma->Instance = stream;
+    dma->Init.Channel = channel;
+    dma->Init.Direction = direction;
+    dma->Init.PeriphInc = DMA_PINC_DISABLE;
+    dma->Init.MemInc = DMA_MINC_ENABLE;
+    dma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    dma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    dma->Init.Mode = DMA_NORMAL;
+    dma->Init.Priority = DMA_PRIORITY_LOW;
+    dma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(dma);
+
+    HAL_NVIC_SetPriority(irq, I2C_BUS_IRQ_PRIO, 0);
+    HAL_NVIC_EnableIRQ(irq);
+}
+
+static HAL_StatusTypeDef transferPolling(I2cBus *bus, I2cRequest *request)
+{
+    switch (request->op)
+    {
+    case I2C_OP_READ:
+        return HAL_I2C_Mem_Read(bus->handle, request->address, request->reg, request->regSize, request->data,
+                                request->size, I2C_BUS_POLL_TIMEOUT_MS);
+    case I2C_OP_WRITE:
+        return HAL_I2C_Mem_Write(bus->handle, request->address, request->reg, request->regSize, request->data,
+                                 request->size, I2C_BUS_POLL_TIMEOUT_MS);
+    default:
+        return HAL_I2C_IsDeviceReady(bus->handle, request->address, 1, I2C_BUS_POLL_TIMEOUT_MS);
+    }
+}
+
+static void recover(I2cBus *bus)
+{
+    // Like the BSP after an error: restart the peripheral, and stop the DMA stream left running
+    HAL_DMA_Abort(&bus->dmaRx);
+    HAL_DMA_Abort(&bus->dmaTx);
+    HAL_I2C_DeInit(bus->handle);
+    HAL_I2C_Init(bus->handle);
+
+    // Drop a completion that came too late
+    xSemaphoreTake(bus->doneSemaphore, 0);
+}
+
+static HAL_StatusTypeDef transfer(I2cBus *bus, I2cRequest *request)
+{
+    if (request->op == I2C_OP_PROBE)
+    {
+        // A single address byte, shorter than a context switch
+        return transferPolling(bus, request);
+    }
+
+    bool useDma = request->size >= I2C_BUS_DMA_MIN_SIZE && request->size <= I2C_BUS_DMA_BUFFER_SIZE;
+    HAL_StatusTypeDef status;
+
+    if (request->op == I2C_OP_READ)
+    {
+        if (useDma)
+        {
+            status = HAL_I2C_Mem_Read_DMA(bus->handle, request->address, request->reg, request->regSize,
+                                          bus->dmaBuffer, request->size);
+        }
+        else
+        {
+            status = HAL_I2C_Mem_Read_IT(bus->handle, request->address, request->reg, request->regSize,
+                                         request->data, request->size);
+        }
+    }
+    else
+    {
+        if (useDma)
+        {
+            memcpy(bus->dmaBuffer, request->data, request->size);
+            cleanDCache(bus->dmaBuffer, request->size);
+            status = HAL_I2C_Mem_Write_DMA(bus->handle, request->address, request->reg, request->regSize,
+                                           bus->dmaBuffer, request->size);
+        }
+        else
+        {
+            status = HAL_I2C_Mem_Write_IT(bus->handle, request->address, request->reg, request->regSize,
+                                          request->data, request->size);
+        }
+    }
+
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+
+    // Errors (no acknowledge) never complete, they end with the timeout: twice the transfer time
+    // with the address and register bytes, plus a tick
+    uint32_t timeoutMs = 2 + (request->size + 4) * 9 * 1000 * 2 / I2C_BUS_CLOCK_HZ;
+    if (xSemaphoreTake(bus->doneSemaphore, pdMS_TO_TICKS(timeoutMs)) != pdTRUE)
+    {
+        recover(bus);
+        return HAL_TIMEOUT;
+    }
+
+    if (request->op == I2C_OP_READ && useDma)
+    {
+        invalidateDCache(bus->dmaBuffer, request->size);
+        memcpy(request->data, bus->dmaBuffer, request->size);
+    }
+
+    return HAL_OK;
+}
+
+static void busTask(void *pvParameters)
+{
+    I2cBus *bus = (I2cBus *)pvParameters;
+
+    while (1)
+    {
+        // One notification per queued request
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+
+        I2cRequest *request = NULL;
+        for (int priority = 0; priority < I2C_PRIORITY_COUNT; priority++)
+        {
+            if (xQueueReceive(bus->queues[priority], &request, 0) == pdTRUE)
+            {
+                break;
+            }
+        }
+        if (request == NULL)
+        {
+            continue;
+        }
+
+        request->status = transfer(bus, request);
+        if (request->done != NULL)
+        {
+            request->done(request);
+        }
+    }
+}
+
+void i2cBusBegin(I2cBusId id)
+{
+    I2cBus *bus = &buses[id];
+    const I2cBusHardware *hw = &hardware[id];
+
+    if (bus->started)
+    {
+        return;
+    }
+    bus->started = true;
+
+    TwoWire *wire = &Wire;
+    if (id == I2C_BUS_AUDIO)
+    {
+        audioWire.setSDA(PH_8);
+        audioWire.setSCL(PH_7);
+        wire = &audioWire;
+    }
+    wire->begin();
+    wire->setClock(I2C_BUS_CLOCK_HZ);
+    bus->handle = wire->getHandle();
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    initDma(&bus->dmaRx, hw->rxStream, hw->dmaChannel, DMA_PERIPH_TO_MEMORY, hw->rxIrq);
+    initDma(&bus->dmaTx, hw->txStream, hw->dmaChannel, DMA_MEMORY_TO_PERIPH, hw->txIrq);
+    __HAL_LINKDMA(bus->handle, hdmarx, bus->dmaRx);
+    __HAL_LINKDMA(bus->handle, hdmatx, bus->dmaTx);
+    bus->dmaBuffer = dmaBuffers[id];
+
+    HAL_NVIC_SetPriority(hw->evIrq, I2C_BUS_IRQ_PRIO, 0);
+    HAL_NVIC_SetPriority(hw->erIrq, I2C_BUS_IRQ_PRIO, 0);
+
+    for (int priority = 0; priority < I2C_PRIORITY_COUNT; priority++)
+    {
+        bus->queues[priority] = xQueueCreate(I2C_BUS_QUEUE_SIZE, sizeof(I2cRequest *));
+    }
+    bus->doneSemaphore = xSemaphoreCreateBinary();
+
+    // Above all the tasks using the bus, the game task (MY_TASK_PRIORITY, osPriorityHigh) included, so it
+    // starts the next transfer as soon as one ends instead of sharing time slices with a ready user.
+    // It only runs between two transfers.
+    xTaskCreate(busTask, id == I2C_BUS_AUDIO ? "i2c3" : "i2c1", 512, bus, osPriorityRealtime, &bus->task);
+}
+
+static HAL_StatusTypeDef submit(I2cRequest *request, TickType_t wait)
+{
+    I2cBus *bus = &buses[request->bus];
+
+    if (xQueueSend(bus->queues[request->priority], &request, wait) != pdTRUE)
+    {
+        return HAL_BUSY;
+    }
+    xTaskNotifyGive(bus->task);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef i2cBusSubmit(I2cRequest *request)
+{
+    return submit(request, 0);
+}
+
+static void wakeCaller(I2cRequest *request)
+{
+    xSemaphoreGive((SemaphoreHandle_t)request->user);
+}
+
+static HAL_StatusTypeDef run(I2cRequest *request)
+{
+    // Before the scheduler starts the interrupts are masked and the bus task does not run yet
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+    {
+        return transferPolling(&buses[request->bus], request);
+    }
+
+    StaticSemaphore_t semaphoreBuffer;
+    SemaphoreHandle_t semaphore = xSemaphoreCreateBinaryStatic(&semaphoreBuffer);
+    request->done = wakeCaller;
+    request->user = semaphore;
+
+    HAL_StatusTypeDef status = submit(request, portMAX_DELAY);
+    if (status == HAL_OK)
+    {
+        xSemaphoreTake(semaphore, portMAX_DELAY);
+        status = request->status;
+    }
+
+    vSemaphoreDelete(semaphore);
+    return status;
+}
+
+static void fillRequest(I2cRequest *request, I2cBusId bus, I2cPriority priority, I2cOp op, uint16_t address,
+                        uint16_t reg, uint16_t regSize, uint8_t *data, uint16_t size)
+{
+    request->bus = bus;
+    request->priority = priority;
+    request->op = op;
+    request->address = address;
+    request->reg = reg;
+    request->regSize = regSize;
+    request->data = data;
+    request->size = size;
+}
+
+HAL_StatusTypeDef i2cBusRead(I2cBusId bus, I2cPriority priority, uint16_t address, uint16_t reg, uint16_t regSize,
+                             uint8_t *data, uint16_t size)
+{
+    I2cRequest request;
+    fillRequest(&request, bus, priority, I2C_OP_READ, address, reg, regSize, data, size);
+    return run(&request);
+}
+
+HAL_StatusTypeDef i2cBusWrite(I2cBusId bus, I2cPriority priority, uint16_t address, uint16_t reg, uint16_t regSize,
+                              const uint8_t *data, uint16_t size)
+{
+    I2cRequest request;
+    fillRequest(&request, bus, priority, I2C_OP_WRITE, address, reg, regSize, (uint8_t *)data, size);
+    return run(&request);
+}
+
+HAL_StatusTypeDef i2cBusProbe(I2cBusId bus, I2cPriority priority, uint16_t address, uint32_t trials)
+{
+    I2cRequest request;
+    HAL_StatusTypeDef status = HAL_ERROR;
+
+    // One poll per request, so other transfers can go between the polls
+    for (uint32_t i = 0; i < trials && status != HAL_OK; i++)
+    {
+        fillRequest(&request, bus, priority, I2C_OP_PROBE, address, 0, 0, NULL, 0);
+        status = run(&request);
+    }
+    return status;
+}
+
+void i2cBusDelay(uint32_t ms)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+    {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+        return;
+    }
+
+    // HAL_Delay() would hang: the tick interrupt is masked once a FreeRTOS object exists
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        delayMicroseconds(1000);
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include "stm32f7xx_hal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The two I2C buses of the board
+typedef enum
+{
+    I2C_BUS_AUDIO, // I2C3: touch screen and audio codec
+    I2C_BUS_EXT,   // I2C1: EEPROM, camera and Arduino connector (MPU6050)
+    I2C_BUS_COUNT
+} I2cBusId;
+
+// Priority classes, the waiting request of the highest class goes next on the bus. A transfer
+// is never interrupted, so long writes are split by their drivers (EEPROM pages).
+typedef enum
+{
+    I2C_PRIORITY_INPUT,   // touch and motion sensors, read every frame
+    I2C_PRIORITY_CONTROL, // codec and camera registers
+    I2C_PRIORITY_STORAGE, // EEPROM
+    I2C_PRIORITY_COUNT
+} I2cPriority;
+
+typedef enum
+{
+    I2C_OP_READ,
+    I2C_OP_WRITE,
+    I2C_OP_PROBE // one address poll, for the EEPROM write cycle
+} I2cOp;
+
+#ifndef I2C_BUS_CLOCK_HZ
+#define I2C_BUS_CLOCK_HZ 400000
+#endif
+
+// Requests waiting on one bus, for each class
+#ifndef I2C_BUS_QUEUE_SIZE
+#define I2C_BUS_QUEUE_SIZE 8
+#endif
+
+// Transfers from this size go through DMA, shorter ones through interrupts
+#define I2C_BUS_DMA_MIN_SIZE 4
+
+// The DMA works on one cache aligned buffer per bus, larger transfers use interrupts
+#define I2C_BUS_DMA_BUFFER_SIZE 256
+
+typedef struct I2cRequest I2cRequest;
+
+struct I2cRequest
+{
+    I2cBusId bus;
+    I2cPriority priority;
+    I2cOp op;
+    uint16_t address; // 8 bit form, as the HAL and the BSP use it
+    uint16_t reg;
+    uint16_t regSize; // I2C_MEMADD_SIZE_8BIT or I2C_MEMADD_SIZE_16BIT
+    uint8_t *data;
+    uint16_t size;
+
+    // Called from the bus task when the transfer is over, status holds the result
+    void (*done)(I2cRequest *request);
+    void *user;
+    HAL_StatusTypeDef status;
+};
+
+// Starts the bus task and the peripheral, can be called again. Call it before the scheduler
+// starts, the first transfers are done by polling until then.
+void i2cBusBegin(I2cBusId bus);
+
+// Queues a request, it must stay valid until its done callback. Returns HAL_BUSY if the queue
+// of its class is full.
+HAL_StatusTypeDef i2cBusSubmit(I2cRequest *request);
+
+// Synchronous transfers: the calling task sleeps until the bus task completed them.
+// Must not be called from a done callback.
+HAL_StatusTypeDef i2cBusRead(I2cBusId bus, I2cPriority priority, uint16_t address, uint16_t reg, uint16_t regSize,
+                             uint8_t *data, uint16_t size);
+HAL_StatusTypeDef i2cBusWrite(I2cBusId bus, I2cPriority priority, uint16_t address, uint16_t reg, uint16_t regSize,
+                              const uint8_t *data, uint16_t size);
+HAL_StatusTypeDef i2cBusProbe(I2cBusId bus, I2cPriority priority, uint16_t address, uint32_t trials);
+
+// Sleeps when the scheduler runs, for the delays of the device drivers
+void i2cBusDelay(uint32_t ms);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // I2C_BUS_H
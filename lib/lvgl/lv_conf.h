@@ -26,8 +26,11 @@
    COLOR SETTINGS
  *====================*/
 
-/*Color depth: 1 (I1), 8 (L8), 16 (RGB565), 24 (RGB888), 32 (XRGB8888)*/
-#define LV_COLOR_DEPTH 32
+/*Color depth: 1 (I1), 8 (L8), 16 (RGB565), 24 (RGB888), 32 (XRGB8888)
+ *Can be overridden per environment in platformio.ini*/
+#ifndef LV_COLOR_DEPTH
+    #define LV_COLOR_DEPTH 32
+#endif
 
 /*=========================
    STDLIB WRAPPER SETTINGS
@@ -55,8 +58,14 @@
     /*Size of the memory available for `lv_malloc()` in bytes (>= 2kB)*/
     #define LV_MEM_SIZE (64 * 1024U)          /*[bytes]*/
 
-    /*Size of the memory expand for `lv_malloc()` in bytes*/
-    #define LV_MEM_POOL_EXPAND_SIZE 0
+    /*Size of the memory expand for `lv_malloc()` in bytes.
+     *TLSF is built for pools up to `LV_MEM_SIZE + LV_MEM_POOL_EXPAND_SIZE`: it bounds the SDRAM pool
+     *that lvglDrivers adds to `LV_MEM_TIER_LARGE`*/
+    #define LV_MEM_POOL_EXPAND_SIZE (2 * 1024 * 1024U)
+
+    /*`lv_malloc()` takes blocks from this size in bytes from the `LV_MEM_TIER_LARGE` pools,
+     *if any was added with `lv_mem_add_pool_to_tier()`*/
+    #define LV_MEM_LARGE_SIZE_MIN (1024U)     /*[bytes]*/
 
     /*Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too.*/
     #define LV_MEM_ADR 0     /*0: unused*/
@@ -181,7 +190,11 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
-    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    /*The C blend loops until the cycles per pixel of the Cortex-M7's DSP (SIMD) back-end are measured on the board.
+     *env:disco_f746ng_blend_bench builds with LV_DRAW_SW_ASM_ARMV7EM, env:disco_f746ng_blend_bench_c with the C loops.*/
+    #ifndef LV_USE_DRAW_SW_ASM
+        #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    #endif
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
         #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
@@ -234,6 +247,19 @@
 /* Use Renesas Dave2D on RA  platforms. */
 #define LV_USE_DRAW_DAVE2D 0
 
+/* Use the DMA2D (Chrom-ART) of STM32 MCUs for fills, image copies and glyph blending. */
+#define LV_USE_DRAW_DMA2D 1
+
+#if LV_USE_DRAW_DMA2D
+    /* HAL header providing the DMA2D registers and the CMSIS cache functions, e.g. "stm32f7xx_hal.h" */
+    #define LV_DRAW_DMA2D_HAL_INCLUDE "stm32f7xx_hal.h"
+
+    /* 1: complete the draw tasks from the transfer complete interrupt.
+     *    Call `lv_draw_dma2d_transfer_complete_interrupt_handler()` from `DMA2D_IRQHandler()`.
+     * 0: poll the DMA2D while dispatching. */
+    #define LV_USE_DRAW_DMA2D_INTERRUPT 1
+#endif
+
 /* Draw using cached SDL textures*/
 #define LV_USE_DRAW_SDL 0
 
@@ -369,6 +395,12 @@
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Size in bytes of the bitmaps kept for the objects with `LV_OBJ_FLAG_CACHE_AS_BITMAP`.
+ *Such an object is rendered with its children into an ARGB8888 bitmap once, then the bitmap is drawn
+ *until a child is invalidated. The least recently drawn bitmaps are freed to stay in this budget.
+ *0: disable the cache, the flag has no effect*/
+#define LV_OBJ_BITMAP_CACHE_SIZE (1024 * 1024U)   /*[bytes] the two 480x272 menus, in the SDRAM tier*/
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -378,7 +410,20 @@
 #define LV_COLOR_MIX_ROUND_OFS  0
 
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
-#define LV_OBJ_STYLE_CACHE      0
+#define LV_OBJ_STYLE_CACHE      1
+
+/* Number of resolved style properties (part, state, property) cached in each object.
+ * An object allocates 4 + 8 x N bytes on its first style property read, from the fast heap tier.
+ * A style, state or parent change of an object empties its cache and the caches of its descendants.
+ * Report the changes of shared styles with `lv_obj_report_style_change()`.
+ * 16: 132 bytes per object, about 3 KB for the game. test_style_cache_stats misses 39% (lv_demo_widgets) and
+ * 43% (lv_demo_benchmark) of the reads, 26% and 23% with 32 entries, which take twice the memory.
+ * 0: disable, every property read walks the object's styles and its parents*/
+#define LV_OBJ_STYLE_PROP_CACHE_CNT 16
+
+/* Count the style property reads, the reads resolved from the styles (not found in the objects' cache)
+ * and the walks of a style list. Read them with `lv_obj_get_style_cache_stats()`*/
+#define LV_OBJ_STYLE_CACHE_STATS 0
 
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
@@ -858,10 +903,13 @@
  *==================*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
-/*1: Enable system monitor component*/
-#define LV_USE_SYSMON   0
+/*1: Enable system monitor component
+ *Can be overridden per environment in platformio.ini*/
+#ifndef LV_USE_SYSMON
+    #define LV_USE_SYSMON   0
+#endif
 #if LV_USE_SYSMON
     /*Get the idle percentage. E.g. uint32_t my_get_idle(void);*/
     #define LV_SYSMON_GET_IDLE lv_timer_get_idle
@@ -181,6 +181,8 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
+    /*LV_DRAW_SW_ASM_NONE, LV_DRAW_SW_ASM_NEON, LV_DRAW_SW_ASM_HELIUM,
+     *LV_DRAW_SW_ASM_ARMV7EM (Cortex-M4/M7 DSP instructions) or LV_DRAW_SW_ASM_CUSTOM*/
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -234,6 +236,19 @@
 /* Use Renesas Dave2D on RA  platforms. */
 #define LV_USE_DRAW_DAVE2D 0
 
+/* Use the DMA2D (Chrom-ART) of STM32 MCUs for fills, image copies and glyph blending. */
+#define LV_USE_DRAW_DMA2D 0
+
+#if LV_USE_DRAW_DMA2D
+    /* HAL header providing the DMA2D registers and the CMSIS cache functions, e.g. "stm32f7xx_hal.h" */
+    #define LV_DRAW_DMA2D_HAL_INCLUDE "stm32f7xx_hal.h"
+
+    /* 1: complete the draw tasks from the transfer complete interrupt.
+     *    Call `lv_draw_dma2d_transfer_complete_interrupt_handler()` from `DMA2D_IRQHandler()`.
+     * 0: poll the DMA2D while dispatching. */
+    #define LV_USE_DRAW_DMA2D_INTERRUPT 0
+#endif
+
 /* Draw using cached SDL textures*/
 #define LV_USE_DRAW_SDL 0
 
@@ -369,6 +384,12 @@
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Size in bytes of the bitmaps kept for the objects with `LV_OBJ_FLAG_CACHE_AS_BITMAP`.
+ *Such an object is rendered with its children into an ARGB8888 bitmap once, then the bitmap is drawn
+ *until a child is invalidated. The least recently drawn bitmaps are freed to stay in this budget.
+ *0: disable the cache, the flag has no effect*/
+#define LV_OBJ_BITMAP_CACHE_SIZE 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -380,6 +401,17 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Number of resolved style properties (part, state, property) cached in each object.
+ * An object allocates 4 + 8 x N bytes on its first style property read.
+ * A style, state or parent change of an object empties its cache and the caches of its descendants.
+ * Report the changes of shared styles with `lv_obj_report_style_change()`.
+ * 0: disable, every property read walks the object's styles and its parents*/
+#define LV_OBJ_STYLE_PROP_CACHE_CNT 0
+
+/* Count the style property reads, the reads resolved from the styles (not found in the objects' cache)
+ * and the walks of a style list. Read them with `lv_obj_get_style_cache_stats()`*/
+#define LV_OBJ_STYLE_CACHE_STATS 0
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -49,6 +49,7 @@ fout.write(
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_ARMV7EM      3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -26,6 +26,7 @@ extern "C" {
 #include "../misc/lv_ll.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_style.h"
+#include "../core/lv_obj_style.h"
 #include "../misc/lv_timer.h"
 #include "../osal/lv_os.h"
 #include "../others/sysmon/lv_sysmon.h"
@@ -89,6 +90,12 @@ typedef struct lv_global_t {
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    uint32_t style_generation;
+#endif
+#if LV_OBJ_STYLE_CACHE_STATS
+    lv_obj_style_cache_stats_t style_cache_stats;
+#endif
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -121,6 +128,11 @@ typedef struct lv_global_t {
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
 
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    lv_ll_t obj_bitmap_cache_ll;
+    uint32_t obj_bitmap_cache_used;
+#endif
+
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
     lv_draw_sw_shadow_cache_t sw_shadow_cache;
@@ -26,6 +26,7 @@
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
 #include "lv_obj_draw_private.h"
+#include "lv_obj_bitmap_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -291,6 +292,9 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    if(f & LV_OBJ_FLAG_CACHE_AS_BITMAP) lv_obj_bitmap_cache_remove(obj);
+#endif
 }
 
 void lv_obj_update_flag(lv_obj_t * obj, lv_obj_flag_t f, bool v)
@@ -525,6 +529,10 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     /*Remove the animations from this object*/
     lv_anim_delete(obj, NULL);
 
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    lv_obj_bitmap_cache_remove(obj);
+#endif
+
     /*Delete from the group*/
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
@@ -541,6 +549,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         obj->spec_attr = NULL;
     }
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    lv_free(obj->style_prop_cache);
+    obj->style_prop_cache = NULL;
+#endif
+
 #if LV_OBJ_ID_AUTO_ASSIGN
     lv_obj_free_id(obj);
 #endif
@@ -906,8 +919,15 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
 
     /*Invalidate the object in their current state*/
     lv_obj_invalidate(obj);
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    lv_obj_bitmap_cache_invalidate(obj);
+#endif
 
     obj->state = new_state;
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    /*The children inherit the properties of the new state*/
+    lv_obj_style_prop_cache_invalidate(obj, LV_STYLE_PROP_ANY);
+#endif
     lv_obj_update_layer_type(obj);
     lv_obj_style_transition_dsc_t * ts = lv_malloc_zeroed(sizeof(lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
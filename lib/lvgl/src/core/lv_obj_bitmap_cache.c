@@ -0,0 +1,274 @@
+/**
+ * @file lv_obj_bitmap_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_bitmap_cache_private.h"
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+
+#include "lv_obj_private.h"
+#include "lv_obj_draw_private.h"
+#include "lv_refr_private.h"
+#include "lv_global.h"
+#include "../display/lv_display_private.h"
+#include "../draw/lv_draw_private.h"
+#include "../misc/cache/lv_image_cache.h"
+#include "../stdlib/lv_string.h"
+#include "../stdlib/lv_sprintf.h"
+#include "../misc/lv_area_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define cache_ll_p &(LV_GLOBAL_DEFAULT()->obj_bitmap_cache_ll)
+#define cache_used LV_GLOBAL_DEFAULT()->obj_bitmap_cache_used
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const lv_obj_t * obj;
+    lv_draw_buf_t * draw_buf;   /**< NULL until the first draw and after an eviction*/
+    int32_t scroll_x;           /**< Scroll position the children were rendered with*/
+    int32_t scroll_y;
+    uint8_t valid : 1;          /**< The bitmap matches the subtree*/
+    uint8_t rendering : 1;      /**< Being rendered: a nested cached object must not evict it*/
+} lv_obj_bitmap_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_bitmap_cache_entry_t * find_entry(const lv_obj_t * obj);
+static void free_draw_buf(lv_obj_bitmap_cache_entry_t * entry);
+static void make_room(uint32_t size);
+static lv_result_t render(lv_obj_bitmap_cache_entry_t * entry, lv_obj_t * obj, const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_bitmap_cache_init(void)
+{
+    lv_ll_init(cache_ll_p, sizeof(lv_obj_bitmap_cache_entry_t));
+    cache_used = 0;
+}
+
+void lv_obj_bitmap_cache_deinit(void)
+{
+    lv_obj_bitmap_cache_entry_t * entry;
+    LV_LL_READ(cache_ll_p, entry) {
+        free_draw_buf(entry);
+    }
+    lv_ll_clear(cache_ll_p);
+}
+
+void lv_obj_bitmap_cache_invalidate(lv_obj_t * obj)
+{
+    LV_ASSERT_NULL(obj);
+
+    lv_obj_bitmap_cache_entry_t * entry = find_entry(obj);
+    if(entry) entry->valid = 0;
+}
+
+uint32_t lv_obj_bitmap_cache_get_used_size(void)
+{
+    return cache_used;
+}
+
+bool lv_obj_bitmap_cache_draw(lv_layer_t * layer, lv_obj_t * obj)
+{
+    lv_area_t area;
+    int32_t ext_size = lv_obj_get_ext_draw_size(obj);
+    lv_area_copy(&area, &obj->coords);
+    lv_area_increase(&area, ext_size, ext_size);
+
+    /*Nothing to draw here, but keep the bitmap for the other areas*/
+    if(!lv_area_is_on(&layer->_clip_area, &area)) return true;
+
+    int32_t w = lv_area_get_width(&area);
+    int32_t h = lv_area_get_height(&area);
+    uint32_t size = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) * h;
+    if(size > LV_OBJ_BITMAP_CACHE_SIZE) {
+        LV_LOG_WARN("%" LV_PRId32 "x%" LV_PRId32 " object is larger than LV_OBJ_BITMAP_CACHE_SIZE, not cached", w, h);
+        return false;
+    }
+
+    lv_obj_bitmap_cache_entry_t * entry = find_entry(obj);
+    if(entry == NULL) {
+        entry = lv_ll_ins_head(cache_ll_p);
+        LV_ASSERT_MALLOC(entry);
+        if(entry == NULL) return false;
+        lv_memzero(entry, sizeof(lv_obj_bitmap_cache_entry_t));
+        entry->obj = obj;
+    }
+    else {
+        /*Most recently used first, the evictions start from the tail*/
+        lv_ll_move_before(cache_ll_p, entry, lv_ll_get_head(cache_ll_p));
+    }
+
+    if(entry->draw_buf && (entry->draw_buf->header.w != w || entry->draw_buf->header.h != h)) {
+        free_draw_buf(entry);
+    }
+
+    if(entry->draw_buf == NULL) {
+        make_room(size);
+        entry->draw_buf = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+        if(entry->draw_buf == NULL) {
+            LV_LOG_WARN("couldn't allocate the bitmap");
+            return false;
+        }
+        cache_used += entry->draw_buf->data_size;
+        entry->valid = 0;
+    }
+
+    /*Scrolling moves the children without invalidating them one by one*/
+    if(entry->scroll_x != lv_obj_get_scroll_x(obj) || entry->scroll_y != lv_obj_get_scroll_y(obj)) {
+        entry->valid = 0;
+    }
+
+    if(!entry->valid) {
+        if(render(entry, obj, &area) != LV_RESULT_OK) return false;
+    }
+
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+    img_dsc.base.obj = obj;
+    img_dsc.src = entry->draw_buf;
+    lv_draw_image(layer, &img_dsc, &area);
+
+    return true;
+}
+
+void lv_obj_bitmap_cache_invalidate_parents(const lv_obj_t * obj)
+{
+    /*Called on every invalidation, return quickly if nothing is cached*/
+    if(lv_ll_get_head(cache_ll_p) == NULL) return;
+
+    const lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_CACHE_AS_BITMAP)) {
+            lv_obj_bitmap_cache_entry_t * entry = find_entry(parent);
+            if(entry) entry->valid = 0;
+        }
+        parent = lv_obj_get_parent(parent);
+    }
+}
+
+void lv_obj_bitmap_cache_remove(const lv_obj_t * obj)
+{
+    lv_obj_bitmap_cache_entry_t * entry = find_entry(obj);
+    if(entry == NULL) return;
+
+    free_draw_buf(entry);
+    lv_ll_remove(cache_ll_p, entry);
+    lv_free(entry);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_obj_bitmap_cache_entry_t * find_entry(const lv_obj_t * obj)
+{
+    lv_obj_bitmap_cache_entry_t * entry;
+    LV_LL_READ(cache_ll_p, entry) {
+        if(entry->obj == obj) return entry;
+    }
+
+    return NULL;
+}
+
+static void free_draw_buf(lv_obj_bitmap_cache_entry_t * entry)
+{
+    if(entry->draw_buf == NULL) return;
+
+    /*The image cache could hold a decoded copy keyed by the buffer's address*/
+    lv_image_cache_drop(entry->draw_buf);
+    cache_used -= entry->draw_buf->data_size;
+    lv_draw_buf_destroy(entry->draw_buf);
+    entry->draw_buf = NULL;
+    entry->valid = 0;
+}
+
+/**
+ * Free the bitmaps of the least recently used objects until `size` more bytes fit in the budget.
+ * The entries are kept, their bitmap is rendered again when they are drawn next time.
+ * @param size      size of the bitmap to allocate
+ */
+static void make_room(uint32_t size)
+{
+    lv_obj_bitmap_cache_entry_t * entry;
+    LV_LL_READ_BACK(cache_ll_p, entry) {
+        if(cache_used + size <= LV_OBJ_BITMAP_CACHE_SIZE) return;
+        if(entry->rendering) continue;
+        free_draw_buf(entry);
+    }
+}
+
+/**
+ * Render the object and its children into the entry's bitmap
+ * @param entry     the cache entry of `obj` with an allocated bitmap
+ * @param obj       pointer to an object
+ * @param area      coordinates of the bitmap: the object's area with its ext. draw size
+ * @return          LV_RESULT_OK: the bitmap is up to date
+ */
+static lv_result_t render(lv_obj_bitmap_cache_entry_t * entry, lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_display_t * disp = lv_refr_get_disp_refreshing();
+    if(disp == NULL) return LV_RESULT_INVALID;
+
+    /*Might be the previous content in the image cache*/
+    lv_image_cache_drop(entry->draw_buf);
+    lv_draw_buf_clear(entry->draw_buf, NULL);
+
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+    layer.draw_buf = entry->draw_buf;
+    layer.buf_area = *area;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer._clip_area = *area;
+    layer.phy_clip_area = *area;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    lv_matrix_identity(&layer.matrix);
+#endif
+
+    /*Same as a snapshot: draw only this layer until it's ready.
+     *The objects hidden in the refreshed area are needed in the bitmap.*/
+    lv_layer_t * layer_head_ori = disp->layer_head;
+    uint32_t occluded_cnt_ori = disp->occluded_cnt;
+    disp->layer_head = &layer;
+    disp->occluded_cnt = 0;
+
+    /*Set before drawing: a child invalidated by its draw events marks it again*/
+    entry->valid = 1;
+    entry->rendering = 1;
+    entry->scroll_x = lv_obj_get_scroll_x(obj);
+    entry->scroll_y = lv_obj_get_scroll_y(obj);
+
+    lv_obj_redraw(&layer, obj);
+
+    while(layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    entry->rendering = 0;
+    disp->layer_head = layer_head_ori;
+    disp->occluded_cnt = occluded_cnt_ori;
+
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_OBJ_BITMAP_CACHE_SIZE > 0*/
@@ -0,0 +1,58 @@
+/**
+ * @file lv_obj_bitmap_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_BITMAP_CACHE_H
+#define LV_OBJ_BITMAP_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_types.h"
+
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Render an object with `LV_OBJ_FLAG_CACHE_AS_BITMAP` again on its next refresh.
+ * Invalidating a descendant, a style change, a size or scroll change already does it.
+ * Needed only when the object draws its own content differently without a style change
+ * (e.g. a custom `LV_EVENT_DRAW_MAIN` handler whose data changed).
+ * @param obj       pointer to an object
+ */
+void lv_obj_bitmap_cache_invalidate(lv_obj_t * obj);
+
+/**
+ * Get the size of the draw buffers held by the object bitmap cache.
+ * @return          the used size in bytes, at most `LV_OBJ_BITMAP_CACHE_SIZE`
+ */
+uint32_t lv_obj_bitmap_cache_get_used_size(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_OBJ_BITMAP_CACHE_SIZE > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_BITMAP_CACHE_H*/
@@ -0,0 +1,74 @@
+/**
+ * @file lv_obj_bitmap_cache_private.h
+ *
+ */
+
+#ifndef LV_OBJ_BITMAP_CACHE_PRIVATE_H
+#define LV_OBJ_BITMAP_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_bitmap_cache.h"
+
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the object bitmap cache
+ */
+void lv_obj_bitmap_cache_init(void);
+
+/**
+ * Free all the cached bitmaps
+ */
+void lv_obj_bitmap_cache_deinit(void);
+
+/**
+ * Draw an object with `LV_OBJ_FLAG_CACHE_AS_BITMAP` from its cached bitmap.
+ * The subtree is rendered into the bitmap first if it's missing or out of date.
+ * @param layer     the layer to draw to
+ * @param obj       pointer to an object without layer (no transform, opacity or blend mode)
+ * @return          false: the bitmap couldn't be allocated, draw the object normally
+ */
+bool lv_obj_bitmap_cache_draw(lv_layer_t * layer, lv_obj_t * obj);
+
+/**
+ * Mark the cached bitmaps of the ancestors of an object as out of date.
+ * Called when the object is invalidated.
+ * @param obj       pointer to an object
+ */
+void lv_obj_bitmap_cache_invalidate_parents(const lv_obj_t * obj);
+
+/**
+ * Free the cached bitmap of an object
+ * @param obj       pointer to an object, deleted or whose `LV_OBJ_FLAG_CACHE_AS_BITMAP` was removed
+ */
+void lv_obj_bitmap_cache_remove(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_OBJ_BITMAP_CACHE_SIZE > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_BITMAP_CACHE_PRIVATE_H*/
@@ -15,6 +15,7 @@
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
 #include "../core/lv_global.h"
+#include "lv_obj_bitmap_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -814,6 +815,12 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    /*Even if nothing is visible now, the bitmaps cached by the parents are out of date.
+     *The object's own invalidation (move, hide) doesn't change its bitmap.*/
+    lv_obj_bitmap_cache_invalidate_parents(obj);
+#endif
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
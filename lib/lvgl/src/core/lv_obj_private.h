@@ -54,6 +54,9 @@ struct lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    lv_obj_style_prop_cache_t * style_prop_cache;
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -15,6 +15,7 @@
 #include "../misc/lv_color.h"
 #include "../stdlib/lv_string.h"
 #include "../core/lv_global.h"
+#include "lv_obj_bitmap_cache_private.h"
 /*********************
  *      DEFINES
  *********************/
@@ -24,6 +25,16 @@
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    #define style_generation LV_GLOBAL_DEFAULT()->style_generation
+#endif
+
+#if LV_OBJ_STYLE_CACHE_STATS
+    #define STYLE_CACHE_STAT_INC(field) LV_GLOBAL_DEFAULT()->style_cache_stats.field++
+#else
+    #define STYLE_CACHE_STAT_INC(field) do {} while(0)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -68,6 +79,10 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    static lv_obj_style_prop_cache_t * get_style_prop_cache(lv_obj_t * obj);
+    static uint32_t style_prop_cache_index(uint32_t key);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -260,6 +275,11 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    /*Without the refresh the objects using the style are not looked for: drop every table*/
+    if(!style_refr) lv_obj_style_prop_cache_invalidate(NULL, LV_STYLE_PROP_ANY);
+#endif
+
     if(!style_refr) return;
     lv_display_t * d = lv_display_get_next(NULL);
 
@@ -272,13 +292,46 @@ void lv_obj_report_style_change(lv_style_t * style)
     }
 }
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+void lv_obj_style_prop_cache_invalidate(lv_obj_t * obj, lv_style_prop_t prop)
+{
+    if(obj == NULL) {
+        style_generation++;
+        return;
+    }
+
+    /*Any other generation than the current one: emptied by get_style_prop_cache() if read again*/
+    if(obj->style_prop_cache) obj->style_prop_cache->generation = style_generation - 1;
+
+    if(prop != LV_STYLE_PROP_ANY && !lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE)) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_style_prop_cache_invalidate(obj->spec_attr->children[i], prop);
+    }
+}
+#endif
+
 void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    /*Even if the refresh is disabled: the styles of the object have changed*/
+    lv_obj_style_prop_cache_invalidate(obj, prop);
+#endif
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    /*The object's own look is in its cached bitmap too, but not its position*/
+    if(prop != LV_STYLE_X && prop != LV_STYLE_Y && prop != LV_STYLE_ALIGN &&
+       prop != LV_STYLE_TRANSLATE_X && prop != LV_STYLE_TRANSLATE_Y) {
+        lv_obj_bitmap_cache_invalidate(obj);
+    }
+#endif
 
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
@@ -331,12 +384,43 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
+    STYLE_CACHE_STAT_INC(reads);
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    /*The values read without the transitions are not cached*/
+    lv_obj_style_prop_cache_t * cache = obj->skip_trans ? NULL : get_style_prop_cache((lv_obj_t *)obj);
+    uint32_t key = (selector << 8) | prop;
+    uint32_t idx = style_prop_cache_index(key);
+    if(cache && cache->entries[idx].key == key) return cache->entries[idx].value;
+#endif
+
+    STYLE_CACHE_STAT_INC(resolved);
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    if(cache) {
+        cache->entries[idx].key = key;
+        cache->entries[idx].value = value_act;
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return value_act;
+}
+
+#if LV_OBJ_STYLE_CACHE_STATS
+void lv_obj_get_style_cache_stats(lv_obj_style_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    *stats = LV_GLOBAL_DEFAULT()->style_cache_stats;
 }
 
+void lv_obj_reset_style_cache_stats(void)
+{
+    lv_memzero(&LV_GLOBAL_DEFAULT()->style_cache_stats, sizeof(lv_obj_style_cache_stats_t));
+}
+#endif
+
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
 {
     LV_ASSERT_NULL(obj)
@@ -697,6 +781,7 @@ static lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t sel
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                     lv_style_value_t * v)
 {
+    STYLE_CACHE_STAT_INC(walks);
 
     const uint32_t group = (uint32_t)1 << lv_style_get_prop_group(prop);
     const lv_part_t part = lv_obj_style_get_selector_part(selector);
@@ -784,6 +869,9 @@ static void refresh_children_style(lv_obj_t * obj)
         lv_obj_invalidate(child);
         lv_obj_send_event(child, LV_EVENT_STYLE_CHANGED, NULL);
         lv_obj_invalidate(child);
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+        lv_obj_bitmap_cache_invalidate(child);
+#endif
 
         refresh_children_style(child); /*Check children too*/
     }
@@ -819,6 +907,9 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
                     lv_style_remove_prop((lv_style_t *)obj->styles[i].style, tr->prop);
                 }
             }
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+            lv_obj_style_prop_cache_invalidate(obj, tr->prop);
+#endif
 
             /*Free the transition descriptor too*/
             lv_anim_delete(tr, NULL);
@@ -946,6 +1037,9 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+                lv_obj_style_prop_cache_invalidate(obj, prop);
+#endif
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1124,3 +1218,34 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+/**
+ * Get the resolved property cache of an object, allocate it or empty it if the styles have changed
+ * @param obj       pointer to an object
+ * @return          the cache or NULL if it couldn't be allocated
+ */
+static lv_obj_style_prop_cache_t * get_style_prop_cache(lv_obj_t * obj)
+{
+    lv_obj_style_prop_cache_t * cache = obj->style_prop_cache;
+    if(cache == NULL) {
+        cache = lv_malloc(sizeof(lv_obj_style_prop_cache_t));
+        if(cache == NULL) return NULL;
+        obj->style_prop_cache = cache;
+    }
+    else if(cache->generation == style_generation) {
+        return cache;
+    }
+
+    lv_memzero(cache->entries, sizeof(cache->entries));
+    cache->generation = style_generation;
+    return cache;
+}
+
+static uint32_t style_prop_cache_index(uint32_t key)
+{
+    /*Knuth's multiplicative hash. Its upper bits are the well mixed ones: scale it to the table size*/
+    uint32_t h = (key ^ (key >> 16)) * 2654435761U;
+    return (uint32_t)(((uint64_t)h * LV_OBJ_STYLE_PROP_CACHE_CNT) >> 32);
+}
+#endif
@@ -34,6 +34,14 @@ typedef enum {
 
 typedef uint32_t lv_style_selector_t;
 
+#if LV_OBJ_STYLE_CACHE_STATS
+typedef struct {
+    uint32_t reads;     /**< Calls of `lv_obj_get_style_prop()`*/
+    uint32_t resolved;  /**< Reads not found in the object's property cache, resolved from the styles*/
+    uint32_t walks;     /**< Walks of the style list of an object, the parents' too for inherited properties*/
+} lv_obj_style_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -138,6 +146,20 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
  */
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop);
 
+#if LV_OBJ_STYLE_CACHE_STATS
+/**
+ * Get the number of style property reads since the start or the last reset, to measure the style caches
+ * (`LV_OBJ_STYLE_CACHE` and `LV_OBJ_STYLE_PROP_CACHE_CNT`).
+ * @param stats     store the counters here
+ */
+void lv_obj_get_style_cache_stats(lv_obj_style_cache_stats_t * stats);
+
+/**
+ * Reset the style property read counters to zero
+ */
+void lv_obj_reset_style_cache_stats(void);
+#endif
+
 /**
  * Set local style property on an object's part and state.
  * @param obj       pointer to an object
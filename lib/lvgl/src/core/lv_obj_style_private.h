@@ -31,6 +31,22 @@ struct lv_obj_style_t {
     uint32_t is_trans : 1;
 };
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+/**
+ * The resolved style properties of an object, allocated on its first style property read.
+ * The entries are valid only while `generation` matches the global style generation.
+ * Changing the styles, the state or the parent of an object drops its table and the tables of its
+ * descendants, which may inherit the changed properties.
+ */
+struct lv_obj_style_prop_cache_t {
+    uint32_t generation;
+    struct {
+        uint32_t key;               /**< `(part | state) << 8 | prop`, 0: empty*/
+        lv_style_value_t value;
+    } entries[LV_OBJ_STYLE_PROP_CACHE_CNT];
+};
+#endif
+
 struct lv_obj_style_transition_dsc_t {
     uint16_t time;
     uint16_t delay;
@@ -84,6 +100,16 @@ lv_style_state_cmp_t lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t state
  */
 void lv_obj_update_layer_type(lv_obj_t * obj);
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+/**
+ * Drop the resolved style properties of an object, e.g. when its styles, its state or its parent change.
+ * The tables are only marked, they are emptied on their next read.
+ * @param obj       the object, its descendants too if `prop` is inheritable. NULL: all the objects
+ * @param prop      the changed property, `LV_STYLE_PROP_ANY` if not known
+ */
+void lv_obj_style_prop_cache_invalidate(lv_obj_t * obj, lv_style_prop_t prop);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_style_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
 #include "../display/lv_display.h"
@@ -186,6 +187,10 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children[lv_obj_get_child_count(parent) - 1] = obj;
 
     obj->parent = parent;
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    /*The inherited properties come from the new parent*/
+    lv_obj_style_prop_cache_invalidate(obj, LV_STYLE_PROP_ANY);
+#endif
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
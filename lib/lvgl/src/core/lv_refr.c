@@ -8,6 +8,7 @@
  *********************/
 #include "lv_refr_private.h"
 #include "lv_obj_draw_private.h"
+#include "lv_obj_bitmap_cache_private.h"
 #include "../misc/lv_area_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../draw/lv_draw_mask_private.h"
@@ -32,19 +33,35 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+/*Uncovered parts of a refreshed area tracked by the occlusion culling*/
+#ifndef LV_REFR_OCCLUSION_PIECES
+    #define LV_REFR_OCCLUSION_PIECES 16
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    lv_area_t pieces[LV_REFR_OCCLUSION_PIECES]; /**< Parts of the area not covered by opaque objects yet*/
+    uint32_t piece_cnt;
+} refr_occlusion_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static int32_t inv_merge_cost(const lv_area_t * a1_p, const lv_area_t * a2_p);
+static void inv_merge_find_partner(lv_display_t * disp, uint32_t i);
+static void inv_area_merge(lv_display_t * disp, const lv_area_t * area_p);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_layer_t * layer);
-static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+static lv_obj_t * occlusion_scan(refr_occlusion_t * occ, lv_obj_t * obj, const lv_area_t * clip_p, bool can_cover);
+static bool occlusion_is_covered(const refr_occlusion_t * occ, const lv_area_t * area_p);
+static void occlusion_subtract(refr_occlusion_t * occ, const lv_area_t * cover_p);
+static bool refr_is_occluded(const lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
@@ -316,13 +333,15 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     }
 
     /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area merge the cheapest two*/
+        disp->inv_overflow_cnt++;
+        inv_area_merge(disp, &com_area);
+    }
+    else {
+        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_p++;
+        disp->inv_merge_ready = 0;
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
-    disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
@@ -474,6 +493,112 @@ static void lv_refr_join_area(void)
     LV_PROFILER_END;
 }
 
+/**
+ * Get how many pixels would be redrawn only because two areas are merged
+ * @param a1_p      pointer to an area
+ * @param a2_p      pointer to an other area
+ * @return          the size of the joined area minus the size of the areas (negative if they overlap)
+ */
+static int32_t inv_merge_cost(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    lv_area_t joined_area;
+    lv_area_join(&joined_area, a1_p, a2_p);
+    return (int32_t)lv_area_get_size(&joined_area) - (int32_t)lv_area_get_size(a1_p) -
+           (int32_t)lv_area_get_size(a2_p);
+}
+
+/**
+ * Find the saved area which is the cheapest to merge with a saved area
+ * @param disp      pointer to a display
+ * @param i         index of the saved area
+ */
+static void inv_merge_find_partner(lv_display_t * disp, uint32_t i)
+{
+    disp->inv_merge_cost[i] = INT32_MAX;
+    uint32_t j;
+    for(j = 0; j < disp->inv_p; j++) {
+        if(j == i) continue;
+        int32_t cost = inv_merge_cost(&disp->inv_areas[i], &disp->inv_areas[j]);
+        if(cost < disp->inv_merge_cost[i]) {
+            disp->inv_merge_cost[i] = cost;
+            disp->inv_merge_partner[i] = j;
+        }
+    }
+}
+
+/**
+ * Make room for an area when the invalid area buffer is full: merge the pair of areas (the new one
+ * included) which adds the least redrawn pixels, instead of redrawing the whole screen.
+ * The cheapest partner of each saved area is kept between the calls, so only the areas related
+ * to the merged ones are compared again with all the others.
+ * @param disp      pointer to a display with a full invalid area buffer
+ * @param area_p    the area to save
+ */
+static void inv_area_merge(lv_display_t * disp, const lv_area_t * area_p)
+{
+    uint32_t i;
+    if(!disp->inv_merge_ready) {
+        for(i = 0; i < disp->inv_p; i++) inv_merge_find_partner(disp, i);
+        disp->inv_merge_ready = 1;
+    }
+
+    /*The cheapest pair of saved areas*/
+    uint32_t pair_i = 0;
+    for(i = 1; i < disp->inv_p; i++) {
+        if(disp->inv_merge_cost[i] < disp->inv_merge_cost[pair_i]) pair_i = i;
+    }
+
+    /*The cheapest saved area to merge the new one into*/
+    uint32_t new_j = 0;
+    int32_t new_cost = INT32_MAX;
+    for(i = 0; i < disp->inv_p; i++) {
+        int32_t cost = inv_merge_cost(area_p, &disp->inv_areas[i]);
+        if(cost < new_cost) {
+            new_cost = cost;
+            new_j = i;
+        }
+    }
+
+    /*Up to two saved areas change*/
+    uint32_t changed1;
+    uint32_t changed2;
+    if(new_cost <= disp->inv_merge_cost[pair_i]) {
+        lv_area_join(&disp->inv_areas[new_j], &disp->inv_areas[new_j], area_p);
+        changed1 = new_j;
+        changed2 = new_j;
+    }
+    else {
+        uint32_t pair_j = disp->inv_merge_partner[pair_i];
+        lv_area_join(&disp->inv_areas[pair_i], &disp->inv_areas[pair_i], &disp->inv_areas[pair_j]);
+        /*The new area takes the place of the merged one*/
+        disp->inv_areas[pair_j] = *area_p;
+        changed1 = pair_i;
+        changed2 = pair_j;
+    }
+
+    for(i = 0; i < disp->inv_p; i++) {
+        uint32_t partner = disp->inv_merge_partner[i];
+        if(i == changed1 || i == changed2 || partner == changed1 || partner == changed2) {
+            inv_merge_find_partner(disp, i);
+            continue;
+        }
+
+        /*Only the changed areas can be cheaper partners now*/
+        int32_t cost = inv_merge_cost(&disp->inv_areas[i], &disp->inv_areas[changed1]);
+        if(cost < disp->inv_merge_cost[i]) {
+            disp->inv_merge_cost[i] = cost;
+            disp->inv_merge_partner[i] = changed1;
+        }
+        if(changed2 != changed1) {
+            cost = inv_merge_cost(&disp->inv_areas[i], &disp->inv_areas[changed2]);
+            if(cost < disp->inv_merge_cost[i]) {
+                disp->inv_merge_cost[i] = cost;
+                disp->inv_merge_partner[i] = changed2;
+            }
+        }
+    }
+}
+
 /**
  * Refresh the sync areas
  */
@@ -718,88 +843,191 @@ static void refr_area_part(lv_layer_t * layer)
         lv_draw_buf_clear(layer->draw_buf, &a);
     }
 
-    lv_obj_t * top_act_scr = NULL;
-    lv_obj_t * top_prev_scr = NULL;
-
-    /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(&layer->_clip_area, lv_display_get_screen_active(disp_refr));
-    if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(&layer->_clip_area, disp_refr->prev_scr);
-    }
-
-    /*Draw a bottom layer background if there is no top object*/
-    if(top_act_scr == NULL && top_prev_scr == NULL) {
-        refr_obj_and_children(layer, lv_display_get_layer_bottom(disp_refr));
-    }
-
+    /*The roots in drawing order*/
+    lv_obj_t * roots[5];
+    int32_t root_cnt = 0;
+    roots[root_cnt++] = lv_display_get_layer_bottom(disp_refr);
     if(disp_refr->draw_prev_over_act) {
-        if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
-        refr_obj_and_children(layer, top_act_scr);
-
-        /*Refresh the previous screen if any*/
-        if(disp_refr->prev_scr) {
-            if(top_prev_scr == NULL) top_prev_scr = disp_refr->prev_scr;
-            refr_obj_and_children(layer, top_prev_scr);
-        }
+        roots[root_cnt++] = disp_refr->act_scr;
+        if(disp_refr->prev_scr) roots[root_cnt++] = disp_refr->prev_scr;
     }
     else {
-        /*Refresh the previous screen if any*/
-        if(disp_refr->prev_scr) {
-            if(top_prev_scr == NULL) top_prev_scr = disp_refr->prev_scr;
-            refr_obj_and_children(layer, top_prev_scr);
+        if(disp_refr->prev_scr) roots[root_cnt++] = disp_refr->prev_scr;
+        roots[root_cnt++] = disp_refr->act_scr;
+    }
+    roots[root_cnt++] = lv_display_get_layer_top(disp_refr);
+    roots[root_cnt++] = lv_display_get_layer_sys(disp_refr);
+
+    /*Collect the opaque objects from the top-most one down, until they cover the whole area.
+     *The objects below are not drawn, and the ones hidden by the objects above them are skipped.*/
+    refr_occlusion_t occ;
+    occ.pieces[0] = layer->_clip_area;
+    occ.piece_cnt = 1;
+    disp_refr->occluded_cnt = 0;
+
+    lv_obj_t * top_obj = NULL;
+    int32_t top_i = 0;  /*If nothing covers the area draw every root from the bottom layer*/
+    int32_t i;
+    for(i = root_cnt - 1; i >= 0; i--) {
+        top_obj = occlusion_scan(&occ, roots[i], &layer->_clip_area, true);
+        if(top_obj) {
+            top_i = i;
+            break;
         }
+    }
 
-        if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
-        refr_obj_and_children(layer, top_act_scr);
+    for(i = top_i; i < root_cnt; i++) {
+        refr_obj_and_children(layer, top_obj && i == top_i ? top_obj : roots[i]);
     }
 
-    /*Also refresh top and sys layer unconditionally*/
-    refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
-    refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
+    disp_refr->occluded_cnt = 0;
 
     draw_buf_flush(disp_refr);
     LV_PROFILER_END;
 }
 
 /**
- * Search the most top object which fully covers an area
- * @param area_p pointer to an area
- * @param obj the first object to start the searching (typically a screen)
- * @return
+ * Walk an object and its children from the top-most one down (the opposite of the drawing order)
+ * and remove the areas they cover opaquely from the uncovered parts of the refreshed area.
+ * The objects whose drawing is already covered by the objects above them are saved as occluded.
+ * @param occ           the uncovered parts of the refreshed area
+ * @param obj           the object to start from, typically a screen or a layer of the display
+ * @param clip_p        the area where the object is drawn
+ * @param can_cover     false if the object is masked by a parent
+ * @return              the object from which the whole area is covered, NULL if it's not covered
  */
-static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
+static lv_obj_t * occlusion_scan(refr_occlusion_t * occ, lv_obj_t * obj, const lv_area_t * clip_p, bool can_cover)
 {
-    lv_obj_t * found_p = NULL;
-
-    if(lv_area_is_in(area_p, &obj->coords, 0) == false) return NULL;
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
-    if(lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return NULL;
+    if(lv_obj_get_style_opa_layered(obj, 0) < LV_OPA_MIN) return NULL;
+
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+
+    /*Transformed objects can be drawn out of their coordinates*/
+    lv_layer_type_t layer_type = lv_obj_get_layer_type(obj);
+    if(layer_type != LV_LAYER_TYPE_TRANSFORM) {
+        lv_area_t drawn_area;
+        if(!lv_area_intersect(&drawn_area, clip_p, &obj_coords_ext)) return NULL;
+
+        /*The object and its children are drawn only here. If it's already covered skip them.*/
+        if(occlusion_is_covered(occ, &drawn_area)) {
+            if(disp_refr->occluded_cnt < LV_REFR_OCCLUDED_MAX) {
+                disp_refr->occluded_objs[disp_refr->occluded_cnt] = obj;
+                disp_refr->occluded_cnt++;
+            }
+            return NULL;
+        }
+    }
+
+    /*Objects drawn on an other layer (opacity, blend mode, transformation) never cover*/
+    if(layer_type != LV_LAYER_TYPE_NONE) return NULL;
 
-    /*If this object is fully cover the draw area then check the children too*/
     lv_cover_check_info_t info;
-    info.res = LV_COVER_RES_COVER;
-    info.area = area_p;
-    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
-    if(info.res == LV_COVER_RES_MASKED) return NULL;
+    info.res = LV_COVER_RES_NOT_COVER;
+    lv_area_t cover_area;
+    if(can_cover && lv_area_intersect(&cover_area, clip_p, &obj->coords)) {
+        info.res = LV_COVER_RES_COVER;
+        info.area = &cover_area;
+        lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    }
 
-    int32_t i;
-    int32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = child_cnt - 1; i >= 0; i--) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        found_p = lv_refr_get_top_obj(area_p, child);
+    /*The children are drawn after the object so they are above it*/
+    const lv_area_t * obj_coords = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE) ? &obj_coords_ext : &obj->coords;
+    lv_area_t clip_coords_for_children;
+    if(lv_area_intersect(&clip_coords_for_children, clip_p, obj_coords)) {
+        /*Children out of the object or masked by it (e.g. rounded clip corner) don't cover*/
+        bool children_can_cover = can_cover && info.res != LV_COVER_RES_MASKED && lv_area_is_on(clip_p, &obj->coords);
+
+        int32_t i;
+        int32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = child_cnt - 1; i >= 0; i--) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            lv_obj_t * found_p = occlusion_scan(occ, child, &clip_coords_for_children, children_can_cover);
+            if(found_p) return found_p;
+        }
+    }
 
-        /*If a children is ok then break*/
-        if(found_p != NULL) {
-            break;
+    if(info.res == LV_COVER_RES_COVER) {
+        occlusion_subtract(occ, &cover_area);
+        if(occ->piece_cnt == 0) return obj;
+    }
+
+    return NULL;
+}
+
+/**
+ * Tell whether an area is fully covered by the opaque objects found so far
+ * @param occ       the uncovered parts of the refreshed area
+ * @param area_p    pointer to an area
+ * @return          true: no uncovered part is on the area
+ */
+static bool occlusion_is_covered(const refr_occlusion_t * occ, const lv_area_t * area_p)
+{
+    uint32_t i;
+    for(i = 0; i < occ->piece_cnt; i++) {
+        if(lv_area_is_on(&occ->pieces[i], area_p)) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Remove an opaque area from the uncovered parts of the refreshed area.
+ * If the remaining parts don't fit they are kept as they were, i.e. the occlusion is underestimated.
+ * @param occ       the uncovered parts of the refreshed area
+ * @param cover_p   pointer to the opaque area
+ */
+static void occlusion_subtract(refr_occlusion_t * occ, const lv_area_t * cover_p)
+{
+    lv_area_t res[LV_REFR_OCCLUSION_PIECES];
+    uint32_t res_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < occ->piece_cnt; i++) {
+        const lv_area_t * p = &occ->pieces[i];
+        if(!lv_area_is_on(p, cover_p)) {
+            if(res_cnt >= LV_REFR_OCCLUSION_PIECES) return;
+            res[res_cnt++] = *p;
+            continue;
         }
+
+        /*The rows above and below the opaque area, then the columns on its left and right*/
+        lv_area_t n[4];
+        uint32_t n_cnt = 0;
+        int32_t y1 = LV_MAX(p->y1, cover_p->y1);
+        int32_t y2 = LV_MIN(p->y2, cover_p->y2);
+        if(p->y1 < cover_p->y1) lv_area_set(&n[n_cnt++], p->x1, p->y1, p->x2, cover_p->y1 - 1);
+        if(p->y2 > cover_p->y2) lv_area_set(&n[n_cnt++], p->x1, cover_p->y2 + 1, p->x2, p->y2);
+        if(p->x1 < cover_p->x1) lv_area_set(&n[n_cnt++], p->x1, y1, cover_p->x1 - 1, y2);
+        if(p->x2 > cover_p->x2) lv_area_set(&n[n_cnt++], cover_p->x2 + 1, y1, p->x2, y2);
+
+        if(res_cnt + n_cnt > LV_REFR_OCCLUSION_PIECES) return;
+        uint32_t j;
+        for(j = 0; j < n_cnt; j++) res[res_cnt++] = n[j];
     }
 
-    /*If no better children use this object*/
-    if(found_p == NULL && info.res == LV_COVER_RES_COVER) {
-        found_p = obj;
+    lv_memcpy(occ->pieces, res, res_cnt * sizeof(lv_area_t));
+    occ->piece_cnt = res_cnt;
+}
+
+/**
+ * Tell whether an object was found hidden by the objects above it in the refreshed area
+ * @param obj       pointer to an object
+ * @return          true: the object and its children don't need to be drawn
+ */
+static bool refr_is_occluded(const lv_obj_t * obj)
+{
+    /*`lv_obj_redraw` can be called out of a refresh too (e.g. snapshot)*/
+    if(disp_refr == NULL) return false;
+
+    uint32_t i;
+    for(i = 0; i < disp_refr->occluded_cnt; i++) {
+        if(disp_refr->occluded_objs[i] == obj) return true;
     }
 
-    return found_p;
+    return false;
 }
 
 /**
@@ -1015,10 +1243,18 @@ static bool refr_check_obj_clip_overflow(lv_layer_t * layer, lv_obj_t * obj)
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    if(refr_is_occluded(obj)) return;
 
     lv_opa_t opa = lv_obj_get_style_opa_layered(obj, 0);
     if(opa < LV_OPA_MIN) return;
 
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    /*Objects drawn through a layer (transform, opacity, blend mode) are drawn normally*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP) && lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_NONE) {
+        if(lv_obj_bitmap_cache_draw(layer, obj)) return;
+    }
+#endif
+
 #if LV_DRAW_TRANSFORM_USE_MATRIX
     /*If the layer opa is full then use the matrix transform*/
     if(opa >= LV_OPA_MAX && !refr_check_obj_clip_overflow(layer, obj)) {
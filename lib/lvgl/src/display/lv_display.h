@@ -506,6 +506,14 @@ void lv_display_enable_invalidation(lv_display_t * disp, bool en);
  */
 bool lv_display_is_invalidation_enabled(lv_display_t * disp);
 
+/**
+ * Get how many invalidated areas did not fit in the `LV_INV_BUF_SIZE` buffer
+ * and were merged into a saved one, since the display was created.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          the number of overflows
+ */
+uint32_t lv_display_get_inv_overflow_count(lv_display_t * disp);
+
 /**
  * Get a pointer to the screen refresher timer to
  * modify its parameters with `lv_timer_...` functions.
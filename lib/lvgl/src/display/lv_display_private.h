@@ -29,6 +29,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_REFR_OCCLUDED_MAX
+#define LV_REFR_OCCLUDED_MAX 16 /**< Objects hidden by opaque objects above them skipped in a refreshed area */
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -102,6 +106,12 @@ struct lv_display_t {
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p;
     int32_t inv_en_cnt;
+    uint32_t inv_overflow_cnt;  /**< Areas merged because `inv_areas` was full*/
+
+    /** Cheapest area to merge with each invalidated area, valid while `inv_merge_ready` is set*/
+    int32_t inv_merge_cost[LV_INV_BUF_SIZE];
+    uint16_t inv_merge_partner[LV_INV_BUF_SIZE];
+    uint32_t inv_merge_ready : 1;
 
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
@@ -154,6 +164,10 @@ struct lv_display_t {
     /** The area being refreshed*/
     lv_area_t refreshed_area;
 
+    /** Objects fully hidden in `refreshed_area` by opaque objects drawn after them*/
+    lv_obj_t * occluded_objs[LV_REFR_OCCLUDED_MAX];
+    uint32_t occluded_cnt;
+
 #if LV_USE_PERF_MONITOR
     lv_obj_t * perf_label;
     lv_sysmon_backend_data_t perf_sysmon_backend;
@@ -302,6 +302,15 @@ void lv_draw_dispatch_request(void)
 #endif
 }
 
+void lv_draw_dispatch_request_isr(void)
+{
+#if LV_USE_OS
+    lv_thread_sync_signal_isr(&_draw_info.sync);
+#else
+    _draw_info.dispatch_req = 1;
+#endif
+}
+
 uint32_t lv_draw_get_unit_count(void)
 {
     return _draw_info.unit_cnt;
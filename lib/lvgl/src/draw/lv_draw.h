@@ -187,6 +187,12 @@ void lv_draw_wait_for_finish(void);
  */
 void lv_draw_dispatch_request(void);
 
+/**
+ * Same as `lv_draw_dispatch_request` but can be called from an interrupt,
+ * e.g. when a draw unit's hardware signals that it finished a draw task.
+ */
+void lv_draw_dispatch_request_isr(void);
+
 /**
  * Get the total number of draw units.
   */
@@ -600,7 +600,8 @@ static void * buf_malloc(size_t size_bytes, lv_color_format_t color_format)
 
     /*Allocate larger memory to be sure it can be aligned as needed*/
     size_bytes += LV_DRAW_BUF_ALIGN - 1;
-    return lv_malloc(size_bytes);
+    /*Layers and decoded images are big, keep the fast memory for the objects*/
+    return lv_malloc_tier(size_bytes, LV_MEM_TIER_LARGE);
 }
 
 static void buf_free(void * buf)
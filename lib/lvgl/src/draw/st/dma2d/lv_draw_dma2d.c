@@ -0,0 +1,341 @@
+/**
+ * @file lv_draw_dma2d.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_dma2d.h"
+
+#if LV_USE_DRAW_DMA2D
+#include "../../lv_draw_buf_private.h"
+#include "../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define DRAW_UNIT_ID_DMA2D 5
+
+#define DMA2D_ISR_DONE      (DMA2D_ISR_TCIF | DMA2D_ISR_TEIF)
+#define DMA2D_IFCR_DONE     (DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF)
+#define DMA2D_CR_IRQ        (DMA2D_CR_TCIE | DMA2D_CR_TEIE)
+
+#define DCACHE_LINE_SIZE    32U
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
+
+static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+
+static void execute_drawing(lv_draw_dma2d_unit_t * u);
+
+static void transfer_complete(lv_draw_dma2d_unit_t * u);
+
+static void wait_idle(void);
+
+static void dcache_clean(const void * addr, uint32_t size);
+
+static void dcache_clean_invalidate(void * addr, uint32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static lv_draw_dma2d_unit_t * dma2d_unit;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_dma2d_init(void)
+{
+    __HAL_RCC_DMA2D_CLK_ENABLE();
+
+    lv_draw_dma2d_unit_t * draw_dma2d_unit = lv_draw_create_unit(sizeof(lv_draw_dma2d_unit_t));
+    draw_dma2d_unit->base_unit.evaluate_cb = evaluate;
+    draw_dma2d_unit->base_unit.dispatch_cb = dispatch;
+
+    dma2d_unit = draw_dma2d_unit;
+}
+
+void lv_draw_dma2d_deinit(void)
+{
+    /*The unit itself is freed by `lv_draw_deinit`*/
+    dma2d_unit = NULL;
+}
+
+void lv_draw_dma2d_transfer_complete_interrupt_handler(void)
+{
+    if((DMA2D->ISR & DMA2D_ISR_DONE) == 0) return;
+
+    DMA2D->CR &= ~DMA2D_CR_IRQ;
+    DMA2D->IFCR = DMA2D_IFCR_DONE;
+
+    if(dma2d_unit == NULL || dma2d_unit->task_act == NULL) return;
+
+    transfer_complete(dma2d_unit);
+
+    /*The unit is free now, let LVGL give it the next task*/
+    lv_draw_dispatch_request_isr();
+}
+
+uint32_t lv_draw_dma2d_cf_to_cm(lv_color_format_t cf)
+{
+    switch(cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_XRGB8888:
+            return LV_DRAW_DMA2D_CM_ARGB8888;
+        case LV_COLOR_FORMAT_RGB888:
+            return LV_DRAW_DMA2D_CM_RGB888;
+        case LV_COLOR_FORMAT_RGB565:
+            return LV_DRAW_DMA2D_CM_RGB565;
+        default:
+            return LV_DRAW_DMA2D_CM_INVALID;
+    }
+}
+
+bool lv_draw_dma2d_set_dest(lv_draw_dma2d_unit_t * u, const lv_area_t * coords, lv_draw_dma2d_cfg_t * cfg,
+                            lv_area_t * blend_area)
+{
+    lv_layer_t * layer = u->base_unit.target_layer;
+    lv_draw_buf_t * draw_buf = layer->draw_buf;
+
+    if(!lv_area_intersect(blend_area, coords, u->base_unit.clip_area)) return false;
+
+    lv_memzero(cfg, sizeof(lv_draw_dma2d_cfg_t));
+
+    uint32_t px_size = lv_color_format_get_size(draw_buf->header.cf);
+    cfg->w = lv_area_get_width(blend_area);
+    cfg->h = lv_area_get_height(blend_area);
+    cfg->out_address = lv_draw_buf_goto_xy(draw_buf, blend_area->x1 - layer->buf_area.x1,
+                                           blend_area->y1 - layer->buf_area.y1);
+    cfg->out_offset = draw_buf->header.stride / px_size - cfg->w;
+    cfg->out_cm = lv_draw_dma2d_cf_to_cm(draw_buf->header.cf);
+    cfg->out_px_size = px_size;
+
+    /*When blending the destination is also the background*/
+    cfg->bg_address = cfg->out_address;
+    cfg->bg_offset = cfg->out_offset;
+    cfg->bg_cm = cfg->out_cm;
+
+    return true;
+}
+
+void lv_draw_dma2d_start(lv_draw_dma2d_unit_t * u, const lv_draw_dma2d_cfg_t * cfg, bool async)
+{
+    uint32_t out_size = ((cfg->h - 1) * (cfg->w + cfg->out_offset) + cfg->w) * cfg->out_px_size;
+
+    /*The DMA2D works on the memory: write back what the CPU has rendered or decoded*/
+    dcache_clean_invalidate(cfg->out_address, out_size);
+    if(cfg->fg_size) dcache_clean(cfg->fg_address, cfg->fg_size);
+
+    /*The display driver might still use the DMA2D to flush the other buffer. Its interrupt must be
+     *served before the next transfer starts: the driver routes the DMA2D interrupt by its flush state*/
+    wait_idle();
+
+    DMA2D->CR = cfg->mode;
+    DMA2D->OPFCCR = cfg->out_cm;
+    DMA2D->OMAR = (uint32_t)cfg->out_address;
+    DMA2D->OOR = cfg->out_offset;
+    DMA2D->NLR = (cfg->w << DMA2D_NLR_PL_Pos) | cfg->h;
+
+    if(cfg->mode == LV_DRAW_DMA2D_MODE_R2M) {
+        DMA2D->OCOLR = cfg->out_color;
+    }
+    else {
+        DMA2D->FGMAR = (uint32_t)cfg->fg_address;
+        DMA2D->FGOR = cfg->fg_offset;
+        DMA2D->FGPFCCR = cfg->fg_pfc;
+        DMA2D->FGCOLR = cfg->fg_color;
+    }
+
+    if(cfg->mode == LV_DRAW_DMA2D_MODE_M2M_BLEND) {
+        DMA2D->BGMAR = (uint32_t)cfg->bg_address;
+        DMA2D->BGOR = cfg->bg_offset;
+        DMA2D->BGPFCCR = cfg->bg_cm;
+    }
+
+    DMA2D->IFCR = DMA2D_IFCR_DONE;
+
+    if(async) {
+        u->async = true;
+        u->out_address = cfg->out_address;
+        u->out_size = out_size;
+#if LV_USE_DRAW_DMA2D_INTERRUPT
+        DMA2D->CR |= DMA2D_CR_IRQ | DMA2D_CR_START;
+#else
+        DMA2D->CR |= DMA2D_CR_START;
+#endif
+        return;
+    }
+
+    DMA2D->CR |= DMA2D_CR_START;
+    while((DMA2D->ISR & DMA2D_ISR_DONE) == 0);
+    DMA2D->IFCR = DMA2D_IFCR_DONE;
+
+    dcache_clean_invalidate(cfg->out_address, out_size);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
+{
+    LV_UNUSED(draw_unit);
+
+    const lv_draw_dsc_base_t * base_dsc = task->draw_dsc;
+    if(lv_draw_dma2d_cf_to_cm(base_dsc->layer->color_format) == LV_DRAW_DMA2D_CM_INVALID) return 0;
+
+    switch(task->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            if(!lv_draw_dma2d_fill_supported(task->draw_dsc)) return 0;
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            if(!lv_draw_dma2d_image_supported(task->draw_dsc, &task->area)) return 0;
+            break;
+        case LV_DRAW_TASK_TYPE_LABEL: {
+                const lv_draw_label_dsc_t * label_dsc = task->draw_dsc;
+                if(label_dsc->blend_mode != LV_BLEND_MODE_NORMAL) return 0;
+                break;
+            }
+        default:
+            return 0;
+    }
+
+    /*Ahead of the software renderer*/
+    if(task->preference_score > 80) {
+        task->preference_score = 80;
+        task->preferred_draw_unit_id = DRAW_UNIT_ID_DMA2D;
+    }
+
+    return 1;
+}
+
+static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    lv_draw_dma2d_unit_t * u = (lv_draw_dma2d_unit_t *) draw_unit;
+
+#if LV_USE_DRAW_DMA2D_INTERRUPT == 0
+    if(u->task_act) {
+        if((DMA2D->ISR & DMA2D_ISR_DONE) == 0) {
+            /*Keep the dispatcher polling until the transfer is complete*/
+            lv_draw_dispatch_request();
+            return 0;
+        }
+
+        DMA2D->IFCR = DMA2D_IFCR_DONE;
+        transfer_complete(u);
+    }
+#endif
+
+    /*Return immediately if it's busy with a draw task*/
+    if(u->task_act) return 0;
+
+    lv_draw_task_t * t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_DMA2D);
+    if(t == NULL || t->preferred_draw_unit_id != DRAW_UNIT_ID_DMA2D) return LV_DRAW_UNIT_IDLE;
+
+    if(lv_draw_layer_alloc_buf(layer) == NULL) return LV_DRAW_UNIT_IDLE;
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    u->base_unit.target_layer = layer;
+    u->base_unit.clip_area = &t->clip_area;
+    u->task_act = t;
+    u->async = false;
+
+    execute_drawing(u);
+
+    /*Nothing is running in the background (synchronous task or fully clipped): the task is ready*/
+    if(!u->async) {
+        t->state = LV_DRAW_TASK_STATE_READY;
+        u->task_act = NULL;
+        lv_draw_dispatch_request();
+    }
+#if LV_USE_DRAW_DMA2D_INTERRUPT == 0
+    else {
+        lv_draw_dispatch_request();
+    }
+#endif
+
+    return 1;
+}
+
+static void execute_drawing(lv_draw_dma2d_unit_t * u)
+{
+    lv_draw_task_t * t = u->task_act;
+
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            lv_draw_dma2d_fill(u, t->draw_dsc, &t->area, true);
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            lv_draw_dma2d_image(u, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_LABEL:
+            lv_draw_dma2d_label(u, t->draw_dsc, &t->area);
+            break;
+        default:
+            break;
+    }
+}
+
+static void transfer_complete(lv_draw_dma2d_unit_t * u)
+{
+    /*Drop the lines the CPU might have speculatively loaded during the transfer*/
+    dcache_clean_invalidate(u->out_address, u->out_size);
+
+    lv_draw_task_t * t = u->task_act;
+    t->state = LV_DRAW_TASK_STATE_READY;
+    u->task_act = NULL;
+}
+
+static void wait_idle(void)
+{
+    /*Wait for the running transfer and, if it was interrupt driven, for its interrupt to be served*/
+    while((DMA2D->CR & DMA2D_CR_START) ||
+          ((DMA2D->CR & DMA2D_CR_TCIE) && (DMA2D->ISR & DMA2D_ISR_TCIF)));
+}
+
+static void dcache_clean(const void * addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && __DCACHE_PRESENT
+    if(SCB->CCR & SCB_CCR_DC_Msk) {
+        uint32_t start = (uint32_t)addr & ~(DCACHE_LINE_SIZE - 1);
+        uint32_t end = (uint32_t)addr + size;
+        SCB_CleanDCache_by_Addr((uint32_t *)start, (int32_t)(end - start));
+    }
+#else
+    LV_UNUSED(addr);
+    LV_UNUSED(size);
+#endif
+}
+
+static void dcache_clean_invalidate(void * addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && __DCACHE_PRESENT
+    if(SCB->CCR & SCB_CCR_DC_Msk) {
+        uint32_t start = (uint32_t)addr & ~(DCACHE_LINE_SIZE - 1);
+        uint32_t end = (uint32_t)addr + size;
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t *)start, (int32_t)(end - start));
+    }
+#else
+    LV_UNUSED(addr);
+    LV_UNUSED(size);
+#endif
+}
+
+#endif /*LV_USE_DRAW_DMA2D*/
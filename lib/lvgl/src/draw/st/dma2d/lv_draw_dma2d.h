@@ -0,0 +1,169 @@
+/**
+ * @file lv_draw_dma2d.h
+ *
+ */
+
+#ifndef LV_DRAW_DMA2D_H
+#define LV_DRAW_DMA2D_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../lv_conf_internal.h"
+
+#if LV_USE_DRAW_DMA2D
+#include "../../lv_draw_private.h"
+#include "../../lv_draw_rect.h"
+#include "../../lv_draw_image.h"
+#include "../../lv_draw_label.h"
+#include "../../../misc/lv_area_private.h"
+#include LV_DRAW_DMA2D_HAL_INCLUDE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*DMA2D transfer modes (DMA2D_CR MODE field)*/
+#define LV_DRAW_DMA2D_MODE_M2M          (0UL << DMA2D_CR_MODE_Pos)
+#define LV_DRAW_DMA2D_MODE_M2M_PFC      (1UL << DMA2D_CR_MODE_Pos)
+#define LV_DRAW_DMA2D_MODE_M2M_BLEND    (2UL << DMA2D_CR_MODE_Pos)
+#define LV_DRAW_DMA2D_MODE_R2M          (3UL << DMA2D_CR_MODE_Pos)
+
+/*DMA2D color modes (CM field of the PFC control registers)*/
+#define LV_DRAW_DMA2D_CM_ARGB8888       0UL
+#define LV_DRAW_DMA2D_CM_RGB888         1UL
+#define LV_DRAW_DMA2D_CM_RGB565         2UL
+#define LV_DRAW_DMA2D_CM_A8             9UL
+#define LV_DRAW_DMA2D_CM_INVALID        0xFFUL
+
+/*DMA2D alpha modes (AM field of the foreground PFC control register)*/
+#define LV_DRAW_DMA2D_AM_NO_MODIF       (0UL << DMA2D_FGPFCCR_AM_Pos)
+#define LV_DRAW_DMA2D_AM_REPLACE        (1UL << DMA2D_FGPFCCR_AM_Pos)
+#define LV_DRAW_DMA2D_AM_COMBINE        (2UL << DMA2D_FGPFCCR_AM_Pos)
+
+#define LV_DRAW_DMA2D_ALPHA(opa)        ((uint32_t)(opa) << DMA2D_FGPFCCR_ALPHA_Pos)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_draw_unit_t base_unit;
+
+    /*Task being rendered. Cleared by the transfer complete interrupt.*/
+    lv_draw_task_t * volatile task_act;
+
+    /*The task left a transfer running in the background*/
+    bool async;
+
+    /*Output of the running transfer, its cache lines are invalidated when it's complete*/
+    void * out_address;
+    uint32_t out_size;
+} lv_draw_dma2d_unit_t;
+
+/**
+ * Register level description of a DMA2D transfer.
+ * The offsets are in pixels, the addresses point to the first pixel of the area.
+ */
+typedef struct {
+    uint32_t mode;
+
+    void * out_address;
+    uint32_t out_offset;
+    uint32_t out_cm;
+    uint32_t out_color;     /*Only used by register to memory transfers*/
+    uint32_t out_px_size;
+
+    uint32_t w;
+    uint32_t h;
+
+    const void * fg_address;
+    uint32_t fg_offset;
+    uint32_t fg_pfc;        /*Color mode, alpha mode and alpha of the foreground*/
+    uint32_t fg_color;      /*Color of A8 foregrounds*/
+    uint32_t fg_size;       /*Bytes to write back from the D-cache before the transfer*/
+
+    const void * bg_address;
+    uint32_t bg_offset;
+    uint32_t bg_cm;
+} lv_draw_dma2d_cfg_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+void lv_draw_dma2d_init(void);
+
+void lv_draw_dma2d_deinit(void);
+
+/**
+ * Call it from `DMA2D_IRQHandler` when the DMA2D is not used by the display driver.
+ * It completes the running draw task and requests a new dispatching.
+ */
+void lv_draw_dma2d_transfer_complete_interrupt_handler(void);
+
+/**
+ * Convert an LVGL color format to the DMA2D color mode
+ * @param cf        the color format
+ * @return          one of `LV_DRAW_DMA2D_CM_...` or `LV_DRAW_DMA2D_CM_INVALID` if not supported
+ */
+uint32_t lv_draw_dma2d_cf_to_cm(lv_color_format_t cf);
+
+/**
+ * Initialize a transfer whose output, and background when blending, is an area of the target layer
+ * @param u             pointer to the DMA2D draw unit
+ * @param coords        absolute coordinates of the area to draw
+ * @param cfg           the transfer to initialize
+ * @param blend_area    store the absolute coordinates of the clipped area here
+ * @return              false: the area is fully clipped, nothing to draw
+ */
+bool lv_draw_dma2d_set_dest(lv_draw_dma2d_unit_t * u, const lv_area_t * coords, lv_draw_dma2d_cfg_t * cfg,
+                            lv_area_t * blend_area);
+
+/**
+ * Start a transfer. If it was started asynchronously the unit's `task_act`
+ * will be completed from `lv_draw_dma2d_transfer_complete_interrupt_handler`.
+ * @param u         pointer to the DMA2D draw unit
+ * @param cfg       description of the transfer
+ * @param async     true: return right after starting, false: wait until the transfer is complete
+ */
+void lv_draw_dma2d_start(lv_draw_dma2d_unit_t * u, const lv_draw_dma2d_cfg_t * cfg, bool async);
+
+/**
+ * Check whether a fill can be done by the DMA2D
+ * @param dsc       the fill descriptor
+ * @return          true: supported
+ */
+bool lv_draw_dma2d_fill_supported(const lv_draw_fill_dsc_t * dsc);
+
+void lv_draw_dma2d_fill(lv_draw_dma2d_unit_t * u, const lv_draw_fill_dsc_t * dsc, const lv_area_t * coords,
+                        bool async);
+
+/**
+ * Check whether an image can be copied or blended by the DMA2D
+ * @param dsc       the image descriptor
+ * @param coords    the coordinates of the image
+ * @return          true: supported
+ */
+bool lv_draw_dma2d_image_supported(const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+
+void lv_draw_dma2d_image(lv_draw_dma2d_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+
+void lv_draw_dma2d_label(lv_draw_dma2d_unit_t * u, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_DMA2D*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_DMA2D_H*/
@@ -0,0 +1,88 @@
+/**
+ * @file lv_draw_dma2d_fill.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_dma2d.h"
+
+#if LV_USE_DRAW_DMA2D
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static uint32_t color_to_reg(lv_color_t color, uint32_t cm);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_draw_dma2d_fill_supported(const lv_draw_fill_dsc_t * dsc)
+{
+    /*Only plain rectangles*/
+    return dsc->radius == 0 && dsc->grad.dir == LV_GRAD_DIR_NONE;
+}
+
+void lv_draw_dma2d_fill(lv_draw_dma2d_unit_t * u, const lv_draw_fill_dsc_t * dsc, const lv_area_t * coords,
+                        bool async)
+{
+    if(dsc->opa <= LV_OPA_MIN) return;
+
+    lv_draw_dma2d_cfg_t cfg;
+    lv_area_t blend_area;
+    if(!lv_draw_dma2d_set_dest(u, coords, &cfg, &blend_area)) return;
+
+    if(dsc->opa >= LV_OPA_MAX) {
+        cfg.mode = LV_DRAW_DMA2D_MODE_R2M;
+        cfg.out_color = color_to_reg(dsc->color, cfg.out_cm);
+    }
+    else {
+        /*Blend an A8 foreground whose alpha is replaced by `opa`. Its content doesn't matter
+         *so let it read the destination which is at least as large.*/
+        cfg.mode = LV_DRAW_DMA2D_MODE_M2M_BLEND;
+        cfg.fg_address = cfg.out_address;
+        cfg.fg_offset = cfg.out_offset;
+        cfg.fg_pfc = LV_DRAW_DMA2D_CM_A8 | LV_DRAW_DMA2D_AM_REPLACE | LV_DRAW_DMA2D_ALPHA(dsc->opa);
+        cfg.fg_color = lv_color_to_u32(dsc->color) & 0xFFFFFF;
+    }
+
+    lv_draw_dma2d_start(u, &cfg, async);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t color_to_reg(lv_color_t color, uint32_t cm)
+{
+    switch(cm) {
+        case LV_DRAW_DMA2D_CM_RGB565:
+            return lv_color_to_u16(color);
+        case LV_DRAW_DMA2D_CM_RGB888:
+            return lv_color_to_u32(color) & 0xFFFFFF;
+        default:
+            return lv_color_to_u32(color);
+    }
+}
+
+#endif /*LV_USE_DRAW_DMA2D*/
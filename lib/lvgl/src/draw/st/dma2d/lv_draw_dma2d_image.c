@@ -0,0 +1,105 @@
+/**
+ * @file lv_draw_dma2d_image.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_dma2d.h"
+
+#if LV_USE_DRAW_DMA2D
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static uint32_t get_stride(const lv_image_header_t * header);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_draw_dma2d_image_supported(const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    /*Only images already in memory: the DMA2D can't decode*/
+    if(lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) return false;
+
+    const lv_image_dsc_t * img_dsc = dsc->src;
+    const lv_image_header_t * header = &dsc->header;
+    if(img_dsc->data == NULL) return false;
+    if(header->flags & (LV_IMAGE_FLAGS_PREMULTIPLIED | LV_IMAGE_FLAGS_COMPRESSED)) return false;
+    if(lv_draw_dma2d_cf_to_cm(header->cf) == LV_DRAW_DMA2D_CM_INVALID) return false;
+    if(get_stride(header) % lv_color_format_get_size(header->cf)) return false;
+
+    /*Plain copy or blend: no transformation, recoloring, tiling or masking*/
+    if(dsc->rotation != 0 || dsc->skew_x != 0 || dsc->skew_y != 0) return false;
+    if(dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE) return false;
+    if(dsc->recolor_opa > LV_OPA_MIN) return false;
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(dsc->tile || dsc->clip_radius != 0 || dsc->bitmap_mask_src != NULL) return false;
+    if(lv_area_get_width(coords) != header->w || lv_area_get_height(coords) != header->h) return false;
+
+    return true;
+}
+
+void lv_draw_dma2d_image(lv_draw_dma2d_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_dma2d_cfg_t cfg;
+    lv_area_t blend_area;
+    if(!lv_draw_dma2d_set_dest(u, coords, &cfg, &blend_area)) return;
+
+    const lv_image_dsc_t * img_dsc = dsc->src;
+    lv_color_format_t cf = dsc->header.cf;
+    uint32_t px_size = lv_color_format_get_size(cf);
+    uint32_t stride = get_stride(&dsc->header);
+    uint32_t fg_cm = lv_draw_dma2d_cf_to_cm(cf);
+
+    cfg.fg_address = img_dsc->data + (blend_area.y1 - coords->y1) * stride + (blend_area.x1 - coords->x1) * px_size;
+    cfg.fg_offset = stride / px_size - cfg.w;
+    cfg.fg_size = (cfg.h - 1) * stride + cfg.w * px_size;
+
+    lv_color_format_t dest_cf = u->base_unit.target_layer->draw_buf->header.cf;
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && dsc->opa >= LV_OPA_MAX) {
+        /*Opaque: copy, converting the pixels if needed. The alpha of XRGB8888 pixels is set to 0xFF.*/
+        cfg.mode = cf == dest_cf ? LV_DRAW_DMA2D_MODE_M2M : LV_DRAW_DMA2D_MODE_M2M_PFC;
+        cfg.fg_pfc = fg_cm | LV_DRAW_DMA2D_AM_REPLACE | LV_DRAW_DMA2D_ALPHA(LV_OPA_COVER);
+    }
+    else {
+        uint32_t am = cf == LV_COLOR_FORMAT_ARGB8888 ? LV_DRAW_DMA2D_AM_COMBINE : LV_DRAW_DMA2D_AM_REPLACE;
+        cfg.mode = LV_DRAW_DMA2D_MODE_M2M_BLEND;
+        cfg.fg_pfc = fg_cm | am | LV_DRAW_DMA2D_ALPHA(dsc->opa);
+    }
+
+    lv_draw_dma2d_start(u, &cfg, true);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t get_stride(const lv_image_header_t * header)
+{
+    /*Old image descriptors might not set the stride*/
+    if(header->stride) return header->stride;
+    return header->w * lv_color_format_get_size(header->cf);
+}
+
+#endif /*LV_USE_DRAW_DMA2D*/
@@ -0,0 +1,137 @@
+/**
+ * @file lv_draw_dma2d_label.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_dma2d.h"
+
+#if LV_USE_DRAW_DMA2D
+#include "../../lv_draw_label_private.h"
+#include "../../lv_draw_buf_private.h"
+#if LV_USE_DRAW_SW
+    #include "../../sw/lv_draw_sw.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void draw_letter_cb(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc,
+                           lv_draw_fill_dsc_t * fill_draw_dsc, const lv_area_t * fill_area);
+
+static void draw_letter_a8(lv_draw_dma2d_unit_t * u, const lv_draw_glyph_dsc_t * glyph_draw_dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_dma2d_label(lv_draw_dma2d_unit_t * u, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords)
+{
+    if(dsc->opa <= LV_OPA_MIN) return;
+
+    /*The glyph bitmaps are rendered one by one into a shared buffer, so each glyph is blended synchronously*/
+    lv_draw_label_iterate_characters((lv_draw_unit_t *)u, dsc, coords, draw_letter_cb);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void draw_letter_cb(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc,
+                           lv_draw_fill_dsc_t * fill_draw_dsc, const lv_area_t * fill_area)
+{
+    lv_draw_dma2d_unit_t * u = (lv_draw_dma2d_unit_t *)draw_unit;
+
+    if(glyph_draw_dsc) {
+        switch(glyph_draw_dsc->format) {
+            case LV_FONT_GLYPH_FORMAT_A1:
+            case LV_FONT_GLYPH_FORMAT_A2:
+            case LV_FONT_GLYPH_FORMAT_A4:
+            case LV_FONT_GLYPH_FORMAT_A8:
+                /*The bitmaps are always converted to A8*/
+                draw_letter_a8(u, glyph_draw_dsc);
+                break;
+#if LV_USE_DRAW_SW
+            case LV_FONT_GLYPH_FORMAT_NONE: {
+#if LV_USE_FONT_PLACEHOLDER
+                    lv_draw_border_dsc_t border_draw_dsc;
+                    lv_draw_border_dsc_init(&border_draw_dsc);
+                    border_draw_dsc.opa = glyph_draw_dsc->opa;
+                    border_draw_dsc.color = glyph_draw_dsc->color;
+                    border_draw_dsc.width = 1;
+                    lv_draw_sw_border(draw_unit, &border_draw_dsc, glyph_draw_dsc->bg_coords);
+#endif
+                }
+                break;
+            case LV_FONT_GLYPH_FORMAT_IMAGE: {
+#if LV_USE_IMGFONT
+                    lv_draw_image_dsc_t img_dsc;
+                    lv_draw_image_dsc_init(&img_dsc);
+                    img_dsc.opa = glyph_draw_dsc->opa;
+                    img_dsc.src = glyph_draw_dsc->glyph_data;
+                    lv_draw_sw_image(draw_unit, &img_dsc, glyph_draw_dsc->letter_coords);
+#endif
+                }
+                break;
+#endif /*LV_USE_DRAW_SW*/
+            default:
+                break;
+        }
+    }
+
+    if(fill_draw_dsc && fill_area) {
+        if(lv_draw_dma2d_fill_supported(fill_draw_dsc)) {
+            lv_draw_dma2d_fill(u, fill_draw_dsc, fill_area, false);
+        }
+#if LV_USE_DRAW_SW
+        else {
+            lv_draw_sw_fill(draw_unit, fill_draw_dsc, fill_area);
+        }
+#endif
+    }
+}
+
+static void draw_letter_a8(lv_draw_dma2d_unit_t * u, const lv_draw_glyph_dsc_t * glyph_draw_dsc)
+{
+    if(glyph_draw_dsc->opa <= LV_OPA_MIN) return;
+
+    const lv_area_t * letter_coords = glyph_draw_dsc->letter_coords;
+    lv_draw_dma2d_cfg_t cfg;
+    lv_area_t blend_area;
+    if(!lv_draw_dma2d_set_dest(u, letter_coords, &cfg, &blend_area)) return;
+
+    const lv_draw_buf_t * glyph_buf = glyph_draw_dsc->glyph_data;
+    uint32_t stride = glyph_buf->header.stride;
+
+    cfg.mode = LV_DRAW_DMA2D_MODE_M2M_BLEND;
+    cfg.fg_address = glyph_buf->data + (blend_area.y1 - letter_coords->y1) * stride +
+                     (blend_area.x1 - letter_coords->x1);
+    cfg.fg_offset = stride - cfg.w;
+    cfg.fg_size = (cfg.h - 1) * stride + cfg.w;
+    cfg.fg_pfc = LV_DRAW_DMA2D_CM_A8 | LV_DRAW_DMA2D_AM_COMBINE | LV_DRAW_DMA2D_ALPHA(glyph_draw_dsc->opa);
+    cfg.fg_color = lv_color_to_u32(glyph_draw_dsc->color) & 0xFFFFFF;
+
+    lv_draw_dma2d_start(u, &cfg, false);
+}
+
+#endif /*LV_USE_DRAW_DMA2D*/
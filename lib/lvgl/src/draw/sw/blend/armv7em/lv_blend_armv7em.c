@@ -0,0 +1,931 @@
+/**
+ * @file lv_blend_armv7em.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_armv7em.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_ARMV7EM
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+
+#include <arm_acle.h>
+#include "../lv_draw_sw_blend_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The red, green and blue fields of two RGB565 pixels, one pixel in each 16 bit lane*/
+#define LANE_5  0x001F001F
+#define LANE_6  0x003F003F
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Like `lv_color_mix_alpha_cache_t` of the C loops, but the color channels are cheap here:
+ *only the division is saved*/
+typedef struct {
+    uint8_t fg_alpha;
+    uint8_t bg_alpha;
+    uint8_t res_alpha;
+    uint8_t ratio;
+} mix_alpha_cache_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline uint16_t /* LV_ATTRIBUTE_FAST_MEM */ mix_rgb565(uint32_t fg, uint32_t bg, uint32_t mix5);
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ mix_rgb565_x2(uint32_t fg2, uint32_t bg2, uint32_t mix5);
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ read_rgb565_x2(const uint16_t * buf);
+static inline uint16_t /* LV_ATTRIBUTE_FAST_MEM */ mix_argb8888_to_rgb565(uint32_t src, uint32_t bg, uint32_t mix);
+
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ mix_argb8888(uint32_t fg, uint32_t bg, mix_alpha_cache_t * cache);
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ mix_argb8888_opaque_bg(uint32_t fg, uint32_t bg, uint32_t fg_alpha);
+static uint32_t /* LV_ATTRIBUTE_FAST_MEM */ mix_argb8888_alpha_bg(uint32_t fg, uint32_t bg, mix_alpha_cache_t * cache);
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ replace_alpha(uint32_t c, uint32_t alpha);
+
+static inline bool /* LV_ATTRIBUTE_FAST_MEM */ src_is_word_aligned(const lv_draw_sw_blend_image_dsc_t * dsc);
+static inline bool /* LV_ATTRIBUTE_FAST_MEM */ mask_is_at_least(uint32_t mask4, uint32_t limit);
+static inline bool /* LV_ATTRIBUTE_FAST_MEM */ mask_is_at_most(uint32_t mask4, uint32_t limit);
+static inline void * /* LV_ATTRIBUTE_FAST_MEM */ drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*`lv_color_16_16_mix()` works with a 5 bit mix ratio*/
+#define MIX5(mix)   (((uint32_t)(mix) + 4) >> 3)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_SUPPORT_RGB565
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_with_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    uint32_t color16 = lv_color_to_u16(dsc->color);
+    uint32_t mix5 = MIX5(dsc->opa);
+    uint32_t mix5_inv = 32 - mix5;
+
+    /*The color's part of the sums is the same for every pixel*/
+    uint32_t fg_r = ((color16 >> 11) & 0x1F) * 0x10001 * mix5;
+    uint32_t fg_g = ((color16 >> 5) & 0x3F) * 0x10001 * mix5;
+    uint32_t fg_b = (color16 & 0x1F) * 0x10001 * mix5;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        if((lv_uintptr_t)dest_buf_u16 & 0x2) {
+            dest_buf_u16[0] = mix_rgb565(color16, dest_buf_u16[0], mix5);
+            x = 1;
+        }
+
+        uint32_t * dest_buf_u32 = (uint32_t *)&dest_buf_u16[x];
+        int32_t pair_cnt = (w - x) >> 1;
+        int32_t i;
+        for(i = 0; i < pair_cnt; i++) {
+            uint32_t bg2 = dest_buf_u32[i];
+            uint32_t r = ((bg2 >> 11) & LANE_5) * mix5_inv + fg_r;
+            uint32_t g = ((bg2 >> 5) & LANE_6) * mix5_inv + fg_g;
+            uint32_t b = (bg2 & LANE_5) * mix5_inv + fg_b;
+            dest_buf_u32[i] = ((r << 6) & 0xF800F800) | (g & 0x07E007E0) | ((b >> 5) & LANE_5);
+        }
+        x += pair_cnt * 2;
+
+        if(x < w) dest_buf_u16[x] = mix_rgb565(color16, dest_buf_u16[x], mix5);
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_with_mask_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        while(x < w && ((lv_uintptr_t)&mask[x] & 0x3)) {
+            dest_buf_u16[x] = mix_rgb565(color16, dest_buf_u16[x], MIX5(mask[x]));
+            x++;
+        }
+
+        for(; x <= w - 4; x += 4) {
+            uint32_t mask4 = *(const uint32_t *)&mask[x];
+            /*With a mask >= 252 the 5 bit ratio is 32: the color itself.
+             *With a mask <= 3 it's 0: the background remains.*/
+            if(mask_is_at_least(mask4, 252)) {
+                dest_buf_u16[x + 0] = color16;
+                dest_buf_u16[x + 1] = color16;
+                dest_buf_u16[x + 2] = color16;
+                dest_buf_u16[x + 3] = color16;
+            }
+            else if(!mask_is_at_most(mask4, 3)) {
+                dest_buf_u16[x + 0] = mix_rgb565(color16, dest_buf_u16[x + 0], MIX5(mask[x + 0]));
+                dest_buf_u16[x + 1] = mix_rgb565(color16, dest_buf_u16[x + 1], MIX5(mask[x + 1]));
+                dest_buf_u16[x + 2] = mix_rgb565(color16, dest_buf_u16[x + 2], MIX5(mask[x + 2]));
+                dest_buf_u16[x + 3] = mix_rgb565(color16, dest_buf_u16[x + 3], MIX5(mask[x + 3]));
+            }
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_rgb565(color16, dest_buf_u16[x], MIX5(mask[x]));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_mix_mask_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    lv_opa_t opa = dsc->opa;
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        while(x < w && ((lv_uintptr_t)&mask[x] & 0x3)) {
+            dest_buf_u16[x] = mix_rgb565(color16, dest_buf_u16[x], MIX5(LV_OPA_MIX2(mask[x], opa)));
+            x++;
+        }
+
+        for(; x <= w - 4; x += 4) {
+            uint32_t mask4 = *(const uint32_t *)&mask[x];
+            /*The ratio is <= 3 if the mask is, keep the background*/
+            if(mask_is_at_most(mask4, 3)) continue;
+
+            dest_buf_u16[x + 0] = mix_rgb565(color16, dest_buf_u16[x + 0], MIX5(LV_OPA_MIX2(mask[x + 0], opa)));
+            dest_buf_u16[x + 1] = mix_rgb565(color16, dest_buf_u16[x + 1], MIX5(LV_OPA_MIX2(mask[x + 1], opa)));
+            dest_buf_u16[x + 2] = mix_rgb565(color16, dest_buf_u16[x + 2], MIX5(LV_OPA_MIX2(mask[x + 2], opa)));
+            dest_buf_u16[x + 3] = mix_rgb565(color16, dest_buf_u16[x + 3], MIX5(LV_OPA_MIX2(mask[x + 3], opa)));
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_rgb565(color16, dest_buf_u16[x], MIX5(LV_OPA_MIX2(mask[x], opa)));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_with_opa_armv7em(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    uint32_t mix5 = MIX5(dsc->opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        if((lv_uintptr_t)dest_buf_u16 & 0x2) {
+            dest_buf_u16[0] = mix_rgb565(src_buf_u16[0], dest_buf_u16[0], mix5);
+            x = 1;
+        }
+
+        /*The destination is word aligned, the source can be anywhere*/
+        for(; x <= w - 2; x += 2) {
+            uint32_t * dest32 = (uint32_t *)&dest_buf_u16[x];
+            *dest32 = mix_rgb565_x2(read_rgb565_x2(&src_buf_u16[x]), *dest32, mix5);
+        }
+
+        if(x < w) dest_buf_u16[x] = mix_rgb565(src_buf_u16[x], dest_buf_u16[x], mix5);
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_with_mask_armv7em(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        while(x < w && ((lv_uintptr_t)&mask_buf[x] & 0x3)) {
+            dest_buf_u16[x] = mix_rgb565(src_buf_u16[x], dest_buf_u16[x], MIX5(mask_buf[x]));
+            x++;
+        }
+
+        for(; x <= w - 4; x += 4) {
+            uint32_t mask4 = *(const uint32_t *)&mask_buf[x];
+            if(mask_is_at_least(mask4, 252)) {
+                dest_buf_u16[x + 0] = src_buf_u16[x + 0];
+                dest_buf_u16[x + 1] = src_buf_u16[x + 1];
+                dest_buf_u16[x + 2] = src_buf_u16[x + 2];
+                dest_buf_u16[x + 3] = src_buf_u16[x + 3];
+            }
+            else if(!mask_is_at_most(mask4, 3)) {
+                dest_buf_u16[x + 0] = mix_rgb565(src_buf_u16[x + 0], dest_buf_u16[x + 0], MIX5(mask_buf[x + 0]));
+                dest_buf_u16[x + 1] = mix_rgb565(src_buf_u16[x + 1], dest_buf_u16[x + 1], MIX5(mask_buf[x + 1]));
+                dest_buf_u16[x + 2] = mix_rgb565(src_buf_u16[x + 2], dest_buf_u16[x + 2], MIX5(mask_buf[x + 2]));
+                dest_buf_u16[x + 3] = mix_rgb565(src_buf_u16[x + 3], dest_buf_u16[x + 3], MIX5(mask_buf[x + 3]));
+            }
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_rgb565(src_buf_u16[x], dest_buf_u16[x], MIX5(mask_buf[x]));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+        mask_buf += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_armv7em(
+    lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    lv_opa_t opa = dsc->opa;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        while(x < w && ((lv_uintptr_t)&mask_buf[x] & 0x3)) {
+            dest_buf_u16[x] = mix_rgb565(src_buf_u16[x], dest_buf_u16[x], MIX5(LV_OPA_MIX2(mask_buf[x], opa)));
+            x++;
+        }
+
+        for(; x <= w - 4; x += 4) {
+            uint32_t mask4 = *(const uint32_t *)&mask_buf[x];
+            if(mask_is_at_most(mask4, 3)) continue;
+
+            dest_buf_u16[x + 0] = mix_rgb565(src_buf_u16[x + 0], dest_buf_u16[x + 0],
+                                             MIX5(LV_OPA_MIX2(mask_buf[x + 0], opa)));
+            dest_buf_u16[x + 1] = mix_rgb565(src_buf_u16[x + 1], dest_buf_u16[x + 1],
+                                             MIX5(LV_OPA_MIX2(mask_buf[x + 1], opa)));
+            dest_buf_u16[x + 2] = mix_rgb565(src_buf_u16[x + 2], dest_buf_u16[x + 2],
+                                             MIX5(LV_OPA_MIX2(mask_buf[x + 2], opa)));
+            dest_buf_u16[x + 3] = mix_rgb565(src_buf_u16[x + 3], dest_buf_u16[x + 3],
+                                             MIX5(LV_OPA_MIX2(mask_buf[x + 3], opa)));
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_rgb565(src_buf_u16[x], dest_buf_u16[x], MIX5(LV_OPA_MIX2(mask_buf[x], opa)));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+        mask_buf += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_rgb565_armv7em(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t src = src_buf_u32[x];
+            dest_buf_u16[x] = mix_argb8888_to_rgb565(src, dest_buf_u16[x], src >> 24);
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_rgb565_with_opa_armv7em(
+    lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    lv_opa_t opa = dsc->opa;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t src = src_buf_u32[x];
+            dest_buf_u16[x] = mix_argb8888_to_rgb565(src, dest_buf_u16[x], LV_OPA_MIX2(src >> 24, opa));
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_rgb565_with_mask_armv7em(
+    lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        while(x < w && ((lv_uintptr_t)&mask_buf[x] & 0x3)) {
+            uint32_t src = src_buf_u32[x];
+            dest_buf_u16[x] = mix_argb8888_to_rgb565(src, dest_buf_u16[x], LV_OPA_MIX2(src >> 24, mask_buf[x]));
+            x++;
+        }
+
+        for(; x <= w - 4; x += 4) {
+            uint32_t mask4 = *(const uint32_t *)&mask_buf[x];
+            if(mask4 == 0) continue;
+
+            int32_t i;
+            for(i = x; i < x + 4; i++) {
+                uint32_t src = src_buf_u32[i];
+                dest_buf_u16[i] = mix_argb8888_to_rgb565(src, dest_buf_u16[i], LV_OPA_MIX2(src >> 24, mask_buf[i]));
+            }
+        }
+
+        for(; x < w; x++) {
+            uint32_t src = src_buf_u32[x];
+            dest_buf_u16[x] = mix_argb8888_to_rgb565(src, dest_buf_u16[x], LV_OPA_MIX2(src >> 24, mask_buf[x]));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+        mask_buf += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_armv7em(
+    lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    lv_opa_t opa = dsc->opa;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        while(x < w && ((lv_uintptr_t)&mask_buf[x] & 0x3)) {
+            uint32_t src = src_buf_u32[x];
+            dest_buf_u16[x] = mix_argb8888_to_rgb565(src, dest_buf_u16[x], LV_OPA_MIX3(src >> 24, mask_buf[x], opa));
+            x++;
+        }
+
+        for(; x <= w - 4; x += 4) {
+            uint32_t mask4 = *(const uint32_t *)&mask_buf[x];
+            if(mask4 == 0) continue;
+
+            int32_t i;
+            for(i = x; i < x + 4; i++) {
+                uint32_t src = src_buf_u32[i];
+                dest_buf_u16[i] = mix_argb8888_to_rgb565(src, dest_buf_u16[i],
+                                                         LV_OPA_MIX3(src >> 24, mask_buf[i], opa));
+            }
+        }
+
+        for(; x < w; x++) {
+            uint32_t src = src_buf_u32[x];
+            dest_buf_u16[x] = mix_argb8888_to_rgb565(src, dest_buf_u16[x], LV_OPA_MIX3(src >> 24, mask_buf[x], opa));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+        mask_buf += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_DRAW_SW_SUPPORT_ARGB8888*/
+
+#endif /*LV_DRAW_SW_SUPPORT_RGB565*/
+
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_argb8888_with_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    uint32_t opa = dsc->opa;
+    uint32_t color_argb = replace_alpha(lv_color_to_u32(dsc->color), opa);
+
+    mix_alpha_cache_t cache;
+    cache.fg_alpha = 0;
+
+    /*The color's part of the opaque background's mix is the same for every pixel*/
+    uint32_t fg_rb = __uxtb16(color_argb) * opa;
+    uint32_t fg_g = ((color_argb >> 8) & 0xFF) * opa;
+    uint32_t opa_inv = 255 - opa;
+    bool simple_mix = opa > LV_OPA_MIN;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t bg = dest_buf_u32[x];
+            if(simple_mix && bg >= 0xFF000000) {
+                uint32_t rb = __uxtb16(bg) * opa_inv + fg_rb;
+                uint32_t g = ((bg >> 8) & 0xFF) * opa_inv + fg_g;
+                dest_buf_u32[x] = ((rb >> 8) & 0x00FF00FF) | (g & 0xFF00) | 0xFF000000;
+            }
+            else {
+                dest_buf_u32[x] = mix_argb8888(color_argb, bg, &cache);
+            }
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_argb8888_with_mask_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    uint32_t color_rgb = lv_color_to_u32(dsc->color) & 0x00FFFFFF;
+
+    mix_alpha_cache_t cache;
+    cache.fg_alpha = 0;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        while(x < w && ((lv_uintptr_t)&mask[x] & 0x3)) {
+            dest_buf_u32[x] = mix_argb8888(replace_alpha(color_rgb, mask[x]), dest_buf_u32[x], &cache);
+            x++;
+        }
+
+        for(; x <= w - 4; x += 4) {
+            uint32_t mask4 = *(const uint32_t *)&mask[x];
+            int32_t i;
+            /*An almost opaque color is written as it is, with the mask as alpha*/
+            if(mask_is_at_least(mask4, LV_OPA_MAX)) {
+                for(i = 0; i < 4; i++) {
+                    dest_buf_u32[x + i] = color_rgb | (mask4 << 24);
+                    mask4 >>= 8;
+                }
+            }
+            /*An almost transparent color changes only an almost transparent background*/
+            else if(mask_is_at_most(mask4, LV_OPA_MIN)) {
+                for(i = 0; i < 4; i++) {
+                    if(dest_buf_u32[x + i] <= (LV_OPA_MIN << 24 | 0x00FFFFFF)) {
+                        dest_buf_u32[x + i] = color_rgb | (mask4 << 24);
+                    }
+                    mask4 >>= 8;
+                }
+            }
+            else {
+                for(i = 0; i < 4; i++) {
+                    dest_buf_u32[x + i] = mix_argb8888(color_rgb | (mask4 << 24), dest_buf_u32[x + i], &cache);
+                    mask4 >>= 8;
+                }
+            }
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u32[x] = mix_argb8888(replace_alpha(color_rgb, mask[x]), dest_buf_u32[x], &cache);
+        }
+
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_argb8888_mix_mask_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    lv_opa_t opa = dsc->opa;
+    uint32_t color_rgb = lv_color_to_u32(dsc->color) & 0x00FFFFFF;
+
+    mix_alpha_cache_t cache;
+    cache.fg_alpha = 0;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t fg = replace_alpha(color_rgb, LV_OPA_MIX2(mask[x], opa));
+            dest_buf_u32[x] = mix_argb8888(fg, dest_buf_u32[x], &cache);
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_argb8888_armv7em(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+
+    mix_alpha_cache_t cache;
+    cache.fg_alpha = 0;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            dest_buf_u32[x] = mix_argb8888(src_buf_u32[x], dest_buf_u32[x], &cache);
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_argb8888_with_opa_armv7em(
+    lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    lv_opa_t opa = dsc->opa;
+
+    mix_alpha_cache_t cache;
+    cache.fg_alpha = 0;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t src = src_buf_u32[x];
+            uint32_t fg = replace_alpha(src, LV_OPA_MIX2(src >> 24, opa));
+            dest_buf_u32[x] = mix_argb8888(fg, dest_buf_u32[x], &cache);
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_argb8888_with_mask_armv7em(
+    lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    mix_alpha_cache_t cache;
+    cache.fg_alpha = 0;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t src = src_buf_u32[x];
+            uint32_t fg = replace_alpha(src, LV_OPA_MIX2(src >> 24, mask_buf[x]));
+            dest_buf_u32[x] = mix_argb8888(fg, dest_buf_u32[x], &cache);
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+        mask_buf += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_armv7em(
+    lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!src_is_word_aligned(dsc)) return LV_RESULT_INVALID;
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    lv_opa_t opa = dsc->opa;
+
+    mix_alpha_cache_t cache;
+    cache.fg_alpha = 0;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t src = src_buf_u32[x];
+            uint32_t fg = replace_alpha(src, LV_OPA_MIX3(src >> 24, opa, mask_buf[x]));
+            dest_buf_u32[x] = mix_argb8888(fg, dest_buf_u32[x], &cache);
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+        mask_buf += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_DRAW_SW_SUPPORT_ARGB8888*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Mix two RGB565 colors exactly like `lv_color_16_16_mix()`, without its function call
+ * @param fg        the foreground color
+ * @param bg        the background color
+ * @param mix5      the foreground's ratio in 0..32
+ * @return          the mixed color
+ */
+static inline uint16_t LV_ATTRIBUTE_FAST_MEM mix_rgb565(uint32_t fg, uint32_t bg, uint32_t mix5)
+{
+    /*0x7E0F81F = 0b00000111111000001111100000011111*/
+    fg = (fg | (fg << 16)) & 0x7E0F81F;
+    bg = (bg | (bg << 16)) & 0x7E0F81F;
+    uint32_t result = ((((fg - bg) * mix5) >> 5) + bg) & 0x7E0F81F;
+    return (uint16_t)((result >> 16) | result);
+}
+
+/**
+ * Mix two pairs of RGB565 pixels with the same ratio. Each field is in a 16 bit lane
+ * so that the fields of both pixels are multiplied at once.
+ * `fg * mix5 + bg * (32 - mix5)` is the same as `bg + (fg - bg) * mix5` of `lv_color_16_16_mix()`.
+ * @param fg2       two foreground pixels
+ * @param bg2       two background pixels
+ * @param mix5      the foreground's ratio in 0..32
+ * @return          the two mixed pixels
+ */
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM mix_rgb565_x2(uint32_t fg2, uint32_t bg2, uint32_t mix5)
+{
+    uint32_t mix5_inv = 32 - mix5;
+    uint32_t r = ((fg2 >> 11) & LANE_5) * mix5 + ((bg2 >> 11) & LANE_5) * mix5_inv;
+    uint32_t g = ((fg2 >> 5) & LANE_6) * mix5 + ((bg2 >> 5) & LANE_6) * mix5_inv;
+    uint32_t b = (fg2 & LANE_5) * mix5 + (bg2 & LANE_5) * mix5_inv;
+    return ((r << 6) & 0xF800F800) | (g & 0x07E007E0) | ((b >> 5) & LANE_5);
+}
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM read_rgb565_x2(const uint16_t * buf)
+{
+    return buf[0] | ((uint32_t)buf[1] << 16);
+}
+
+/**
+ * Mix an ARGB8888 color to an RGB565 color exactly like `lv_color_24_16_mix()`
+ * @param src       the ARGB8888 color, its alpha is not used
+ * @param bg        the RGB565 background color
+ * @param mix       the ratio of `src`
+ * @return          the mixed RGB565 color
+ */
+static inline uint16_t LV_ATTRIBUTE_FAST_MEM mix_argb8888_to_rgb565(uint32_t src, uint32_t bg, uint32_t mix)
+{
+    if(mix == 0) {
+        return (uint16_t)bg;
+    }
+    else if(mix == 255) {
+        return (uint16_t)(((src >> 8) & 0xF800) | ((src >> 5) & 0x07E0) | ((src >> 3) & 0x001F));
+    }
+    else {
+        uint32_t mix_inv = 255 - mix;
+
+        /*Blue in the low, red in the high lane*/
+        uint32_t rb = ((__uxtb16(src) >> 3) & LANE_5) * mix + ((bg & 0x1F) | ((bg << 5) & 0x001F0000)) * mix_inv;
+        rb = (rb >> 8) & LANE_5;
+
+        /*The two green products summed by one instruction*/
+        uint32_t g = __smlad(((src >> 10) & 0x3F) | (((bg >> 5) & 0x3F) << 16), mix | (mix_inv << 16), 0);
+
+        return (uint16_t)((rb & 0x1F) | ((rb >> 5) & 0xF800) | ((g >> 3) & 0x07E0));
+    }
+}
+
+/**
+ * Mix two ARGB8888 colors exactly like `lv_color_32_32_mix()`
+ * @param fg        the foreground color, with the alpha to mix with
+ * @param bg        the background color
+ * @param cache     the cached ratio of the last semi-transparent background
+ * @return          the mixed color
+ */
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM mix_argb8888(uint32_t fg, uint32_t bg, mix_alpha_cache_t * cache)
+{
+    uint32_t fg_alpha = fg >> 24;
+    uint32_t bg_alpha = bg >> 24;
+
+    /*Pick the foreground if it's fully opaque or the Background is fully transparent*/
+    if(fg_alpha >= LV_OPA_MAX || bg_alpha <= LV_OPA_MIN) {
+        return fg;
+    }
+    /*Transparent foreground: use the Background*/
+    else if(fg_alpha <= LV_OPA_MIN) {
+        return bg;
+    }
+    /*Opaque background: use simple mix*/
+    else if(bg_alpha == 255) {
+        return mix_argb8888_opaque_bg(fg, bg, fg_alpha);
+    }
+    /*Both colors have alpha*/
+    else {
+        return mix_argb8888_alpha_bg(fg, bg, cache);
+    }
+}
+
+/**
+ * Mix the color channels like `lv_color_mix32()`, with blue and red in the 16 bit lanes
+ * @param fg        the foreground color
+ * @param bg        the background color, its alpha is not used
+ * @param fg_alpha  the foreground's ratio in `LV_OPA_MIN + 1..LV_OPA_MAX - 1`
+ * @return          the mixed color, opaque
+ */
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM mix_argb8888_opaque_bg(uint32_t fg, uint32_t bg, uint32_t fg_alpha)
+{
+    uint32_t fg_alpha_inv = 255 - fg_alpha;
+    uint32_t rb = __uxtb16(fg) * fg_alpha + __uxtb16(bg) * fg_alpha_inv;
+    uint32_t g = __smlad(((fg >> 8) & 0xFF) | ((bg << 8) & 0x00FF0000), fg_alpha | (fg_alpha_inv << 16), 0);
+    return ((rb >> 8) & 0x00FF00FF) | (g & 0xFF00) | 0xFF000000;
+}
+
+/**
+ * The rare case of `mix_argb8888()` when the background is semi-transparent.
+ * Not inlined to keep the loops small.
+ */
+static uint32_t LV_ATTRIBUTE_FAST_MEM mix_argb8888_alpha_bg(uint32_t fg, uint32_t bg, mix_alpha_cache_t * cache)
+{
+    uint32_t fg_alpha = fg >> 24;
+    uint32_t bg_alpha = bg >> 24;
+
+    if(fg_alpha != cache->fg_alpha || bg_alpha != cache->bg_alpha) {
+        /*Info:
+         * https://en.wikipedia.org/wiki/Alpha_compositing#Analytical_derivation_of_the_over_operator*/
+        cache->fg_alpha = fg_alpha;
+        cache->bg_alpha = bg_alpha;
+        cache->res_alpha = 255 - LV_OPA_MIX2(255 - fg_alpha, 255 - bg_alpha);
+        cache->ratio = (fg_alpha * 255) / cache->res_alpha;
+    }
+
+    uint32_t res_alpha = (uint32_t)cache->res_alpha << 24;
+    uint32_t ratio = cache->ratio;
+    if(ratio >= LV_OPA_MAX) return (fg & 0x00FFFFFF) | res_alpha;
+    if(ratio <= LV_OPA_MIN) return (bg & 0x00FFFFFF) | res_alpha;
+
+    return (mix_argb8888_opaque_bg(fg, bg, ratio) & 0x00FFFFFF) | res_alpha;
+}
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM replace_alpha(uint32_t c, uint32_t alpha)
+{
+    return (c & 0x00FFFFFF) | (alpha << 24);
+}
+
+/**
+ * The ARGB8888 pixels are read as words, with LDR or LDRD that need an aligned address.
+ * The draw buffers are aligned but an image's data in a C array might not be: let the C loops do it.
+ */
+static inline bool LV_ATTRIBUTE_FAST_MEM src_is_word_aligned(const lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return (((lv_uintptr_t)dsc->src_buf | (lv_uintptr_t)dsc->src_stride) & 0x3) == 0;
+}
+
+/**
+ * Tell if all 4 bytes of a word are >= `limit`, e.g. 4 opaque mask values.
+ * The saturating add reaches 0xFF only in the bytes >= `limit`.
+ */
+static inline bool LV_ATTRIBUTE_FAST_MEM mask_is_at_least(uint32_t mask4, uint32_t limit)
+{
+    return __uqadd8(mask4, (255 - limit) * 0x01010101) == 0xFFFFFFFF;
+}
+
+/**
+ * Tell if all 4 bytes of a word are <= `limit`, e.g. 4 transparent mask values.
+ * The saturating subtraction leaves 0 only in the bytes <= `limit`.
+ */
+static inline bool LV_ATTRIBUTE_FAST_MEM mask_is_at_most(uint32_t mask4, uint32_t limit)
+{
+    return __uqsub8(mask4, limit * 0x01010101) == 0;
+}
+
+static inline void * LV_ATTRIBUTE_FAST_MEM drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif /* defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP */
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_ARMV7EM*/
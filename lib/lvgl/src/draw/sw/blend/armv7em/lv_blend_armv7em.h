@@ -0,0 +1,159 @@
+/**
+ * @file lv_blend_armv7em.h
+ *
+ */
+
+#ifndef LV_BLEND_ARMV7EM_H
+#define LV_BLEND_ARMV7EM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lv_conf_internal.h"
+
+/* detect whether the DSP extension (Cortex-M4/M7/M33...) is available based on arm compilers' standard */
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+
+#include "../../../../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The simple fills and the RGB565 copy are not accelerated:
+ *the C loops already store words, they are bound by the memory bandwidth*/
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    lv_color_blend_to_rgb565_with_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    lv_color_blend_to_rgb565_with_mask_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_color_blend_to_rgb565_mix_mask_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_with_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_with_mask_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_with_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_with_mask_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA(dsc) \
+    lv_color_blend_to_argb8888_with_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK(dsc) \
+    lv_color_blend_to_argb8888_with_mask_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA(dsc) \
+    lv_color_blend_to_argb8888_mix_mask_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_with_opa_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_with_mask_armv7em(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_armv7em(dsc)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*The same results as the C loops, bit by bit.
+ *They return `LV_RESULT_INVALID` for an ARGB8888 source that isn't word aligned: the C loops blend it.*/
+
+lv_result_t lv_color_blend_to_rgb565_with_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc);
+lv_result_t lv_color_blend_to_rgb565_with_mask_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc);
+lv_result_t lv_color_blend_to_rgb565_mix_mask_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_opa_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_mask_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_opa_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_mask_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_color_blend_to_argb8888_with_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc);
+lv_result_t lv_color_blend_to_argb8888_with_mask_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc);
+lv_result_t lv_color_blend_to_argb8888_mix_mask_opa_armv7em(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_opa_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_mask_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+lv_result_t lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_armv7em(lv_draw_sw_blend_image_dsc_t * dsc);
+
+#endif /* defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP */
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_ARMV7EM_H*/
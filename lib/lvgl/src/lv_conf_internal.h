@@ -27,6 +27,7 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_ARMV7EM      3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -187,6 +188,16 @@
         #endif
     #endif
 
+    /*`lv_malloc()` takes blocks from this size in bytes from the `LV_MEM_TIER_LARGE` pools,
+     *if any was added with `lv_mem_add_pool_to_tier()`*/
+    #ifndef LV_MEM_LARGE_SIZE_MIN
+        #ifdef CONFIG_LV_MEM_LARGE_SIZE_MIN
+            #define LV_MEM_LARGE_SIZE_MIN CONFIG_LV_MEM_LARGE_SIZE_MIN
+        #else
+            #define LV_MEM_LARGE_SIZE_MIN (1024U)     /*[bytes]*/
+        #endif
+    #endif
+
     /*Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too.*/
     #ifndef LV_MEM_ADR
         #ifdef CONFIG_LV_MEM_ADR
@@ -693,6 +704,37 @@
     #endif
 #endif
 
+/* Use the DMA2D (Chrom-ART) of STM32 MCUs for fills, image copies and glyph blending. */
+#ifndef LV_USE_DRAW_DMA2D
+    #ifdef CONFIG_LV_USE_DRAW_DMA2D
+        #define LV_USE_DRAW_DMA2D CONFIG_LV_USE_DRAW_DMA2D
+    #else
+        #define LV_USE_DRAW_DMA2D 0
+    #endif
+#endif
+
+#if LV_USE_DRAW_DMA2D
+    /* HAL header providing the DMA2D registers and the CMSIS cache functions, e.g. "stm32f7xx_hal.h" */
+    #ifndef LV_DRAW_DMA2D_HAL_INCLUDE
+        #ifdef CONFIG_LV_DRAW_DMA2D_HAL_INCLUDE
+            #define LV_DRAW_DMA2D_HAL_INCLUDE CONFIG_LV_DRAW_DMA2D_HAL_INCLUDE
+        #else
+            #define LV_DRAW_DMA2D_HAL_INCLUDE "stm32f7xx_hal.h"
+        #endif
+    #endif
+
+    /* 1: complete the draw tasks from the transfer complete interrupt.
+     *    Call `lv_draw_dma2d_transfer_complete_interrupt_handler()` from `DMA2D_IRQHandler()`.
+     * 0: poll the DMA2D while dispatching. */
+    #ifndef LV_USE_DRAW_DMA2D_INTERRUPT
+        #ifdef CONFIG_LV_USE_DRAW_DMA2D_INTERRUPT
+            #define LV_USE_DRAW_DMA2D_INTERRUPT CONFIG_LV_USE_DRAW_DMA2D_INTERRUPT
+        #else
+            #define LV_USE_DRAW_DMA2D_INTERRUPT 0
+        #endif
+    #endif
+#endif
+
 /* Draw using cached SDL textures*/
 #ifndef LV_USE_DRAW_SDL
     #ifdef CONFIG_LV_USE_DRAW_SDL
@@ -1096,6 +1138,18 @@
     #endif
 #endif
 
+/*Size in bytes of the bitmaps kept for the objects with `LV_OBJ_FLAG_CACHE_AS_BITMAP`.
+ *Such an object is rendered with its children into an ARGB8888 bitmap once, then the bitmap is drawn
+ *until a child is invalidated. The least recently drawn bitmaps are freed to stay in this budget.
+ *0: disable the cache, the flag has no effect*/
+#ifndef LV_OBJ_BITMAP_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+        #define LV_OBJ_BITMAP_CACHE_SIZE CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+    #else
+        #define LV_OBJ_BITMAP_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1125,6 +1179,28 @@
     #endif
 #endif
 
+/* Number of resolved style properties (part, state, property) cached in each object.
+ * An object allocates 4 + 8 x N bytes on its first style property read.
+ * Any style, state or parent change empties the caches.
+ * 0: disable, every property read walks the object's styles and its parents*/
+#ifndef LV_OBJ_STYLE_PROP_CACHE_CNT
+    #ifdef CONFIG_LV_OBJ_STYLE_PROP_CACHE_CNT
+        #define LV_OBJ_STYLE_PROP_CACHE_CNT CONFIG_LV_OBJ_STYLE_PROP_CACHE_CNT
+    #else
+        #define LV_OBJ_STYLE_PROP_CACHE_CNT 0
+    #endif
+#endif
+
+/* Count the style property reads, the reads resolved from the styles (not found in the objects' cache)
+ * and the walks of a style list. Read them with `lv_obj_get_style_cache_stats()`*/
+#ifndef LV_OBJ_STYLE_CACHE_STATS
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE_STATS
+        #define LV_OBJ_STYLE_CACHE_STATS CONFIG_LV_OBJ_STYLE_CACHE_STATS
+    #else
+        #define LV_OBJ_STYLE_CACHE_STATS 0
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -15,6 +15,7 @@
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
 #include "core/lv_group_private.h"
+#include "core/lv_obj_bitmap_cache_private.h"
 #include "lv_init.h"
 #include "core/lv_global.h"
 #include "core/lv_obj.h"
@@ -51,6 +52,9 @@
 #if LV_USE_DRAW_DAVE2D
     #include "draw/renesas/dave2d/lv_draw_dave2d.h"
 #endif
+#if LV_USE_DRAW_DMA2D
+    #include "draw/st/dma2d/lv_draw_dma2d.h"
+#endif
 #if LV_USE_DRAW_SDL
     #include "draw/sdl/lv_draw_sdl.h"
 #endif
@@ -210,6 +214,10 @@ void lv_init(void)
     lv_draw_dave2d_init();
 #endif
 
+#if LV_USE_DRAW_DMA2D
+    lv_draw_dma2d_init();
+#endif
+
 #if LV_USE_DRAW_SDL
     lv_draw_sdl_init();
 #endif
@@ -223,6 +231,10 @@ void lv_init(void)
     /*Initialize the screen refresh system*/
     lv_refr_init();
 
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    lv_obj_bitmap_cache_init();
+#endif
+
 #if LV_USE_SYSMON
     lv_sysmon_builtin_init();
 #endif
@@ -383,6 +395,10 @@ void lv_deinit(void)
     lv_theme_mono_deinit();
 #endif
 
+#if LV_OBJ_BITMAP_CACHE_SIZE > 0
+    lv_obj_bitmap_cache_deinit();
+#endif
+
     lv_image_decoder_deinit();
 
     lv_refr_deinit();
@@ -395,6 +411,10 @@ void lv_deinit(void)
 #endif
 #endif
 
+#if LV_USE_DRAW_DMA2D
+    lv_draw_dma2d_deinit();
+#endif
+
 #if LV_USE_DRAW_VGLITE
     lv_draw_vglite_deinit();
 #endif
@@ -56,6 +56,7 @@ extern "C" {
 #include "core/lv_obj_class_private.h"
 #include "core/lv_group_private.h"
 #include "core/lv_obj_event_private.h"
+#include "core/lv_obj_bitmap_cache_private.h"
 #include "misc/lv_timer_private.h"
 #include "misc/lv_area_private.h"
 #include "misc/lv_fs_private.h"
@@ -31,9 +31,16 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static bool heap_reserve(uint32_t cnt);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static bool heap_is_before(const lv_timer_t * a, const lv_timer_t * b);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,44 +97,20 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
-
-    uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
+    /*Run the timers which were due when the handler started, the earliest first.
+     *A timer runs at most once per call: after running it is due `period` ms later at the earliest,
+     *and on equal deadlines the timers which did not run yet are in front (see `heap_is_before()`).*/
+    state_p->run_generation++;
+    while(state_p->heap_size > 0) {
+        lv_timer_t * timer = state_p->heap[0];
+        if((int32_t)(timer->last_run + timer->period - handler_start) > 0) break;
+        if(timer->run_generation == state_p->run_generation) break;
 
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
+        lv_timer_exec(timer);
     }
 
+    uint32_t time_until_next = lv_timer_get_time_until_next();
+
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
     if(idle_period_time >= IDLE_MEAS_PERIOD) {
@@ -167,6 +150,8 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    if(!heap_reserve(state.timer_cnt + 1)) return NULL;
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +163,10 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->run_generation = state.run_generation - 1;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    heap_insert(new_timer);
 
     lv_timer_handler_resume();
 
@@ -194,8 +181,10 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    if(!timer->paused) heap_remove(timer);
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    state.timer_cnt--;
+    if(timer == state.timer_running) state.timer_deleted = true;
 
     lv_free(timer);
 }
@@ -203,13 +192,19 @@ void lv_timer_delete(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
+    if(timer->paused) return;
+
+    heap_remove(timer);
     timer->paused = true;
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
-    timer->paused = false;
+    if(timer->paused) {
+        timer->paused = false;
+        heap_insert(timer);
+    }
     lv_timer_handler_resume();
 }
 
@@ -217,12 +212,14 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    heap_update(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
@@ -247,6 +244,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    heap_update(timer);
     lv_timer_handler_resume();
 }
 
@@ -261,6 +259,12 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.heap);
+    state.heap = NULL;
+    state.heap_size = 0;
+    state.heap_cap = 0;
+    state.timer_cnt = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -270,7 +274,9 @@ uint32_t lv_timer_get_idle(void)
 
 uint32_t lv_timer_get_time_until_next(void)
 {
-    return state.timer_time_until_next;
+    /*The heap top is the timer to run next*/
+    if(state.heap_size == 0) return LV_NO_TIMER_READY;
+    return lv_timer_time_remaining(state.heap[0]);
 }
 
 lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
@@ -305,37 +311,35 @@ bool lv_timer_get_paused(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a timer which is due
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->run_generation = state.run_generation;
+    heap_update(timer);
 
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
+    state.timer_running = timer;
+    state.timer_deleted = false;
 
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
 
-        if(!state.timer_deleted) {
-            LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
-        }
-        else {
-            LV_TRACE_TIMER("timer callback finished");
-        }
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
 
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
+    if(!state.timer_deleted) {
+        LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
+    }
+    else {
+        LV_TRACE_TIMER("timer callback finished");
     }
 
+    LV_ASSERT_MEM_INTEGRITY();
+
     if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             if(timer->auto_delete) {
@@ -349,7 +353,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         }
     }
 
-    return exec;
+    state.timer_running = NULL;
 }
 
 /**
@@ -383,3 +387,107 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+/**
+ * Make room in the heap for every timer
+ * @param cnt the number of timers
+ * @return false if the memory is out
+ */
+static bool heap_reserve(uint32_t cnt)
+{
+    if(cnt <= state.heap_cap) return true;
+
+    uint32_t new_cap = state.heap_cap ? state.heap_cap * 2 : 8;
+    lv_timer_t ** new_heap = lv_realloc(state.heap, new_cap * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    state.heap = new_heap;
+    state.heap_cap = new_cap;
+    return true;
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    uint32_t i = state.heap_size++;
+    state.heap[i] = timer;
+    timer->heap_index = (int32_t)i;
+    heap_sift_up(i);
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = (uint32_t)timer->heap_index;
+    timer->heap_index = -1;
+
+    state.heap_size--;
+    if(i == state.heap_size) return;
+
+    /*Fill the hole with the last timer and move that one to its place*/
+    lv_timer_t * last = state.heap[state.heap_size];
+    state.heap[i] = last;
+    last->heap_index = (int32_t)i;
+    heap_update(last);
+}
+
+/**
+ * Restore the heap order after the next run time of a timer changed
+ * @param timer pointer to lv_timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    if(timer->paused) return;
+
+    uint32_t i = (uint32_t)timer->heap_index;
+    if(i > 0 && heap_is_before(timer, state.heap[(i - 1) / 2])) heap_sift_up(i);
+    else heap_sift_down(i);
+}
+
+/**
+ * Compare the next run time of two timers. The difference of the tick values is signed to survive the
+ * overflow of the tick counter.
+ * On equal time the timer which did not run yet in this `lv_timer_handler()` call goes first,
+ * so a period of 0 can't starve the other due timers.
+ */
+static bool heap_is_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    int32_t diff = (int32_t)((a->last_run + a->period) - (b->last_run + b->period));
+    if(diff != 0) return diff < 0;
+
+    return a->run_generation != state.run_generation && b->run_generation == state.run_generation;
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!heap_is_before(timer, heap[parent])) break;
+
+        heap[i] = heap[parent];
+        heap[i]->heap_index = (int32_t)i;
+        i = parent;
+    }
+    heap[i] = timer;
+    timer->heap_index = (int32_t)i;
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[i];
+    uint32_t size = state.heap_size;
+    while(true) {
+        uint32_t child = 2 * i + 1;
+        if(child >= size) break;
+        if(child + 1 < size && heap_is_before(heap[child + 1], heap[child])) child++;
+        if(!heap_is_before(heap[child], timer)) break;
+
+        heap[i] = heap[child];
+        heap[i]->heap_index = (int32_t)i;
+        i = child;
+    }
+    heap[i] = timer;
+    timer->heap_index = (int32_t)i;
+}
@@ -33,17 +33,24 @@ struct lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    int32_t heap_index;        /**< Position in the deadline heap, -1 while paused */
+    uint32_t run_generation;   /**< `lv_timer_handler()` call in which the timer ran last */
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
 };
 
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
+    lv_timer_t ** heap;        /**< The not paused timers, as a binary min-heap on their next run time */
+    uint32_t heap_size;
+    uint32_t heap_cap;         /**< Always enough for every timer, so resuming one never allocates */
+    uint32_t timer_cnt;
+    uint32_t run_generation;   /**< Incremented by every `lv_timer_handler()` call */
+    lv_timer_t * timer_running; /**< The timer whose callback is being called */
 
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
+    bool timer_deleted;        /**< `timer_running` was deleted by its callback */
     uint32_t timer_time_until_next;
 
     bool already_running;
@@ -258,6 +258,10 @@ static void perf_update_timer_cb(lv_timer_t * t)
                                                                      info->measured.flush_in_render_elaps_sum) /
                                                                     info->measured.render_cnt) : 0;
 
+    uint32_t inv_overflow_cnt = lv_display_get_inv_overflow_count(disp);
+    info->calculated.inv_overflow_per_sec = time_since_last_report ?
+                                            ((inv_overflow_cnt - info->measured.inv_overflow_start) * 1000 / time_since_last_report) : 0;
+
     info->calculated.cpu_avg_total = ((info->calculated.cpu_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.cpu) / info->calculated.run_cnt;
     info->calculated.fps_avg_total = ((info->calculated.fps_avg_total * (info->calculated.run_cnt - 1)) +
@@ -273,6 +277,7 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.run_cnt = prev_info.calculated.run_cnt;
 
     info->measured.last_report_timestamp = lv_tick_get();
+    info->measured.inv_overflow_start = inv_overflow_cnt;
 }
 
 static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
@@ -284,19 +289,22 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32"), "
            "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
-           "CPU %" LV_PRIu32 "%%\n",
+           "CPU %" LV_PRIu32 "%%, "
+           "%" LV_PRIu32 " inv. overflows/s\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
-           perf->calculated.cpu);
+           perf->calculated.cpu, perf->calculated.inv_overflow_per_sec);
 #else
     lv_obj_t * label = lv_observer_get_target(observer);
     lv_label_set_text_fmt(
         label,
         "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
-        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
+        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")\n"
+        "%" LV_PRIu32" inv. overflows/s",
         perf->calculated.fps, perf->calculated.cpu,
         perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
-        perf->calculated.render_avg_time, perf->calculated.flush_avg_time
+        perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
+        perf->calculated.inv_overflow_per_sec
     );
 #endif /*LV_USE_PERF_MONITOR_LOG_MODE*/
 }
@@ -47,6 +47,7 @@ struct lv_sysmon_perf_info_t {
         uint32_t flush_not_in_render_start;
         uint32_t flush_not_in_render_elaps_sum;
         uint32_t last_report_timestamp;
+        uint32_t inv_overflow_start;    /**< Overflow count of the display at the last report*/
         uint32_t render_in_progress : 1;
     } measured;
 
@@ -56,6 +57,7 @@ struct lv_sysmon_perf_info_t {
         uint32_t refr_avg_time;
         uint32_t render_avg_time;       /**< Pure rendering time without flush time*/
         uint32_t flush_avg_time;        /**< Pure flushing time without rendering time*/
+        uint32_t inv_overflow_per_sec;  /**< Invalidated areas merged because the buffer was full*/
         uint32_t cpu_avg_total;
         uint32_t fps_avg_total;
         uint32_t run_cnt;
@@ -46,6 +46,12 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+static lv_mem_tier_t other_tier(lv_mem_tier_t tier);
+static lv_mem_tier_t find_tier(void * p);
+static void * tier_malloc(lv_mem_tier_t tier, size_t size);
+static void used_add(lv_mem_tier_t tier, size_t size);
+static void used_sub(lv_mem_tier_t tier, size_t size);
+static void monitor(lv_mem_tier_t tier, lv_mem_monitor_t * mon_p);
 
 /**********************
  *  STATIC VARIABLES
@@ -76,22 +82,28 @@ void lv_mem_init(void)
 
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
+    void * work_mem = (void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE);
 #else
     /*Allocate a large array to store the dynamically allocated data*/
     static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT work_mem_int[LV_MEM_SIZE / sizeof(MEM_UNIT)];
-    state.tlsf = lv_tlsf_create_with_pool((void *)work_mem_int, LV_MEM_SIZE);
+    void * work_mem = (void *)work_mem_int;
 #endif
 #else
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
+    void * work_mem = (void *)LV_MEM_ADR;
 #endif
 
-    lv_ll_init(&state.pool_ll, sizeof(lv_pool_t));
+    lv_tlsf_tier_t * fast = &state.tiers[LV_MEM_TIER_FAST];
+    fast->tlsf = lv_tlsf_create_with_pool(work_mem, LV_MEM_SIZE);
+
+    lv_ll_init(&state.pool_ll, sizeof(lv_tlsf_pool_info_t));
 
     /*Record the first pool*/
-    lv_pool_t * pool_p = lv_ll_ins_tail(&state.pool_ll);
-    LV_ASSERT_MALLOC(pool_p);
-    *pool_p = lv_tlsf_get_pool(state.tlsf);
+    lv_tlsf_pool_info_t * info = lv_ll_ins_tail(&state.pool_ll);
+    LV_ASSERT_MALLOC(info);
+    info->pool = lv_tlsf_get_pool(fast->tlsf);
+    info->start = (uintptr_t)work_mem;
+    info->end = (uintptr_t)work_mem + LV_MEM_SIZE;
+    info->tier = LV_MEM_TIER_FAST;
 
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
@@ -101,7 +113,11 @@ void lv_mem_init(void)
 void lv_mem_deinit(void)
 {
     lv_ll_clear(&state.pool_ll);
-    lv_tlsf_destroy(state.tlsf);
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TIER_CNT; i++) {
+        if(state.tiers[i].tlsf) lv_tlsf_destroy(state.tiers[i].tlsf);
+        state.tiers[i].tlsf = NULL;
+    }
 #if LV_USE_OS
     lv_mutex_delete(&state.mutex);
 #endif
@@ -109,45 +125,93 @@ void lv_mem_deinit(void)
 
 lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
 {
-    lv_mem_pool_t new_pool = lv_tlsf_add_pool(state.tlsf, mem, bytes);
+    return lv_mem_add_pool_to_tier(mem, bytes, LV_MEM_TIER_FAST);
+}
+
+lv_mem_pool_t lv_mem_add_pool_to_tier(void * mem, size_t bytes, lv_mem_tier_t tier)
+{
+    LV_ASSERT(tier < LV_MEM_TIER_CNT);
+
+    lv_tlsf_tier_t * t = &state.tiers[tier];
+    lv_mem_pool_t new_pool = NULL;
+    if(t->tlsf) {
+        new_pool = lv_tlsf_add_pool(t->tlsf, mem, bytes);
+    }
+    else if(bytes > lv_tlsf_size()) {
+        /*The first pool of the tier also holds its TLSF control structure*/
+        lv_tlsf_t tlsf = lv_tlsf_create(mem);
+        new_pool = lv_tlsf_add_pool(tlsf, (char *)mem + lv_tlsf_size(), bytes - lv_tlsf_size());
+        if(new_pool) {
+            t->tlsf = tlsf;
+            t->cur_used = 0;
+            t->max_used = 0;
+        }
+    }
+
     if(!new_pool) {
         LV_LOG_WARN("failed to add memory pool, address: %p, size: %zu", mem, bytes);
         return NULL;
     }
 
-    lv_pool_t * pool_p = lv_ll_ins_tail(&state.pool_ll);
-    LV_ASSERT_MALLOC(pool_p);
-    *pool_p = new_pool;
+    lv_tlsf_pool_info_t * info = lv_ll_ins_tail(&state.pool_ll);
+    LV_ASSERT_MALLOC(info);
+    info->pool = new_pool;
+    info->start = (uintptr_t)mem;
+    info->end = (uintptr_t)mem + bytes;
+    info->tier = tier;
 
     return new_pool;
 }
 
 void lv_mem_remove_pool(lv_mem_pool_t pool)
 {
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        if(*pool_p == pool) {
-            lv_ll_remove(&state.pool_ll, pool_p);
-            lv_free(pool_p);
-            lv_tlsf_remove_pool(state.tlsf, pool);
-            return;
+    lv_tlsf_pool_info_t * info;
+    LV_LL_READ(&state.pool_ll, info) {
+        if(info->pool != pool) continue;
+
+        lv_tlsf_tier_t * t = &state.tiers[info->tier];
+        bool control_pool = lv_tlsf_get_pool(t->tlsf) == pool;
+        if(control_pool) {
+            /*The TLSF control structure is in this pool: it can go only with the last pool of the tier*/
+            lv_tlsf_pool_info_t * other;
+            LV_LL_READ(&state.pool_ll, other) {
+                if(other != info && other->tier == info->tier) {
+                    LV_LOG_WARN("the first pool of a tier can be removed only after the others: %p", pool);
+                    return;
+                }
+            }
         }
+
+        lv_ll_remove(&state.pool_ll, info);
+        lv_free(info);
+        lv_tlsf_remove_pool(t->tlsf, pool);
+        if(control_pool) {
+            lv_tlsf_destroy(t->tlsf);
+            t->tlsf = NULL;
+        }
+        return;
     }
     LV_LOG_WARN("invalid pool: %p", pool);
 }
 
 void * lv_malloc_core(size_t size)
+{
+    return lv_malloc_tier_core(size, LV_MEM_TIER_AUTO);
+}
+
+void * lv_malloc_tier_core(size_t size, lv_mem_tier_t tier)
 {
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
-    void * p = lv_tlsf_malloc(state.tlsf, size);
-
-    if(p) {
-        state.cur_used += lv_tlsf_block_size(p);
-        state.max_used = LV_MAX(state.cur_used, state.max_used);
+    if(tier == LV_MEM_TIER_AUTO) {
+        tier = size >= LV_MEM_LARGE_SIZE_MIN ? LV_MEM_TIER_LARGE : LV_MEM_TIER_FAST;
     }
 
+    /*Fall back to the other tier when the preferred one is full*/
+    void * p = tier_malloc(tier, size);
+    if(p == NULL) p = tier_malloc(other_tier(tier), size);
+
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
 #endif
@@ -160,13 +224,23 @@ void * lv_realloc_core(void * p, size_t new_size)
     lv_mutex_lock(&state.mutex);
 #endif
 
+    lv_mem_tier_t tier = find_tier(p);
+    lv_tlsf_tier_t * t = &state.tiers[tier];
     size_t old_size = lv_tlsf_block_size(p);
-    void * p_new = lv_tlsf_realloc(state.tlsf, p, new_size);
+    void * p_new = lv_tlsf_realloc(t->tlsf, p, new_size);
 
     if(p_new) {
-        state.cur_used -= old_size;
-        state.cur_used += lv_tlsf_block_size(p_new);
-        state.max_used = LV_MAX(state.cur_used, state.max_used);
+        used_sub(tier, old_size);
+        used_add(tier, lv_tlsf_block_size(p_new));
+    }
+    else {
+        /*No room left in its tier, move it to the other one*/
+        p_new = tier_malloc(other_tier(tier), new_size);
+        if(p_new) {
+            lv_memcpy(p_new, p, LV_MIN(old_size, new_size));
+            lv_tlsf_free(t->tlsf, p);
+            used_sub(tier, old_size);
+        }
     }
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -184,10 +258,10 @@ void lv_free_core(void * p)
 #if LV_MEM_ADD_JUNK
     lv_memset(p, 0xbb, lv_tlsf_block_size(data));
 #endif
+    lv_mem_tier_t tier = find_tier(p);
     size_t size = lv_tlsf_block_size(p);
-    lv_tlsf_free(state.tlsf, p);
-    if(state.cur_used > size) state.cur_used -= size;
-    else state.cur_used = 0;
+    lv_tlsf_free(state.tiers[tier].tlsf, p);
+    used_sub(tier, size);
 
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -196,27 +270,19 @@ void lv_free_core(void * p)
 
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
 {
-    /*Init the data*/
-    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
-    LV_TRACE_MEM("begin");
-
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
-    }
+    monitor(LV_MEM_TIER_CNT, mon_p);
+    mon_p->max_used = state.max_used;
+}
 
-    mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
-    if(mon_p->free_size > 0) {
-        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
-        mon_p->frag_pct = 100 - mon_p->frag_pct;
-    }
-    else {
-        mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
+void lv_mem_monitor_tier_core(lv_mem_tier_t tier, lv_mem_monitor_t * mon_p)
+{
+    if(tier >= LV_MEM_TIER_CNT) {
+        lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+        return;
     }
 
-    mon_p->max_used = state.max_used;
-
-    LV_TRACE_MEM("finished");
+    monitor(tier, mon_p);
+    mon_p->max_used = state.tiers[tier].max_used;
 }
 
 lv_result_t lv_mem_test_core(void)
@@ -224,17 +290,20 @@ lv_result_t lv_mem_test_core(void)
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
-    if(lv_tlsf_check(state.tlsf)) {
-        LV_LOG_WARN("failed");
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TIER_CNT; i++) {
+        if(state.tiers[i].tlsf && lv_tlsf_check(state.tiers[i].tlsf)) {
+            LV_LOG_WARN("failed");
 #if LV_USE_OS
-        lv_mutex_unlock(&state.mutex);
+            lv_mutex_unlock(&state.mutex);
 #endif
-        return LV_RESULT_INVALID;
+            return LV_RESULT_INVALID;
+        }
     }
 
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        if(lv_tlsf_check_pool(*pool_p)) {
+    lv_tlsf_pool_info_t * info;
+    LV_LL_READ(&state.pool_ll, info) {
+        if(lv_tlsf_check_pool(info->pool)) {
             LV_LOG_WARN("pool failed");
 #if LV_USE_OS
             lv_mutex_unlock(&state.mutex);
@@ -254,6 +323,80 @@ lv_result_t lv_mem_test_core(void)
  *   STATIC FUNCTIONS
  **********************/
 
+static lv_mem_tier_t other_tier(lv_mem_tier_t tier)
+{
+    return tier == LV_MEM_TIER_FAST ? LV_MEM_TIER_LARGE : LV_MEM_TIER_FAST;
+}
+
+static lv_mem_tier_t find_tier(void * p)
+{
+    /*Without large pools every block is in the fast tier*/
+    if(state.tiers[LV_MEM_TIER_LARGE].tlsf == NULL) return LV_MEM_TIER_FAST;
+
+    uintptr_t addr = (uintptr_t)p;
+    lv_tlsf_pool_info_t * info;
+    LV_LL_READ(&state.pool_ll, info) {
+        if(addr >= info->start && addr < info->end) return info->tier;
+    }
+
+    LV_LOG_WARN("%p is not in any pool", p);
+    return LV_MEM_TIER_FAST;
+}
+
+static void * tier_malloc(lv_mem_tier_t tier, size_t size)
+{
+    lv_tlsf_tier_t * t = &state.tiers[tier];
+    if(t->tlsf == NULL) return NULL;
+
+    void * p = lv_tlsf_malloc(t->tlsf, size);
+    if(p) used_add(tier, lv_tlsf_block_size(p));
+    return p;
+}
+
+static void used_add(lv_mem_tier_t tier, size_t size)
+{
+    lv_tlsf_tier_t * t = &state.tiers[tier];
+    t->cur_used += size;
+    t->max_used = LV_MAX(t->cur_used, t->max_used);
+    state.cur_used += size;
+    state.max_used = LV_MAX(state.cur_used, state.max_used);
+}
+
+static void used_sub(lv_mem_tier_t tier, size_t size)
+{
+    lv_tlsf_tier_t * t = &state.tiers[tier];
+    if(t->cur_used > size) t->cur_used -= size;
+    else t->cur_used = 0;
+    if(state.cur_used > size) state.cur_used -= size;
+    else state.cur_used = 0;
+}
+
+static void monitor(lv_mem_tier_t tier, lv_mem_monitor_t * mon_p)
+{
+    /*Init the data*/
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    LV_TRACE_MEM("begin");
+
+    /*LV_MEM_TIER_CNT: every tier*/
+    lv_tlsf_pool_info_t * info;
+    LV_LL_READ(&state.pool_ll, info) {
+        if(tier == LV_MEM_TIER_CNT || info->tier == tier) lv_tlsf_walk_pool(info->pool, lv_mem_walker, mon_p);
+    }
+
+    if(mon_p->total_size > 0) {
+        mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
+    }
+    if(mon_p->free_size > 0) {
+        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
+        mon_p->frag_pct = 100 - mon_p->frag_pct;
+    }
+    else {
+        mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
+    }
+
+    LV_TRACE_MEM("finished");
+}
+
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
 {
     LV_UNUSED(ptr);
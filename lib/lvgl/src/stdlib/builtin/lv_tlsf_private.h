@@ -17,6 +17,7 @@ extern "C" {
  *********************/
 
 #include "lv_tlsf.h"
+#include "../lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -26,12 +27,27 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** A TLSF instance per memory tier*/
+typedef struct {
+    lv_tlsf_t tlsf;     /**< NULL until the first pool of the tier is added*/
+    size_t cur_used;
+    size_t max_used;
+} lv_tlsf_tier_t;
+
+/** Element of `pool_ll`*/
+typedef struct {
+    lv_pool_t pool;
+    uintptr_t start;    /**< Address range of the pool, to find the tier of a block*/
+    uintptr_t end;
+    lv_mem_tier_t tier;
+} lv_tlsf_pool_info_t;
+
 typedef struct {
 #if LV_USE_OS
     lv_mutex_t mutex;
 #endif
-    lv_tlsf_t tlsf;
-    size_t cur_used;
+    lv_tlsf_tier_t tiers[LV_MEM_TIER_CNT];
+    size_t cur_used;    /**< Sum of all the tiers*/
     size_t max_used;
     lv_ll_t  pool_ll;
 } lv_tlsf_state_t;
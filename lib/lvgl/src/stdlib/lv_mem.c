@@ -32,6 +32,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * malloc_core(size_t size, lv_mem_tier_t tier);
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -40,6 +41,10 @@ void * lv_malloc_core(size_t size);
 void * lv_realloc_core(void * p, size_t new_size);
 void lv_free_core(void * p);
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+void * lv_malloc_tier_core(size_t size, lv_mem_tier_t tier);
+void lv_mem_monitor_tier_core(lv_mem_tier_t tier, lv_mem_monitor_t * mon_p);
+#endif
 lv_result_t lv_mem_test_core(void);
 
 /**********************
@@ -60,6 +65,11 @@ lv_result_t lv_mem_test_core(void);
  **********************/
 
 void * lv_malloc(size_t size)
+{
+    return lv_malloc_tier(size, LV_MEM_TIER_AUTO);
+}
+
+void * lv_malloc_tier(size_t size, lv_mem_tier_t tier)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
     if(size == 0) {
@@ -67,7 +77,7 @@ void * lv_malloc(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = malloc_core(size, tier);
 
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
@@ -97,7 +107,7 @@ void * lv_malloc_zeroed(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = malloc_core(size, LV_MEM_TIER_AUTO);
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
@@ -163,6 +173,35 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_mem_monitor_core(mon_p);
 }
 
+void lv_mem_monitor_tier(lv_mem_tier_t tier, lv_mem_monitor_t * mon_p)
+{
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_tier_core(tier, mon_p);
+#else
+    /*A single heap: it is the fast tier*/
+    if(tier == LV_MEM_TIER_FAST) lv_mem_monitor_core(mon_p);
+#endif
+}
+
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_BUILTIN
+lv_mem_pool_t lv_mem_add_pool_to_tier(void * mem, size_t bytes, lv_mem_tier_t tier)
+{
+    LV_UNUSED(tier);
+    return lv_mem_add_pool(mem, bytes);
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static void * malloc_core(size_t size, lv_mem_tier_t tier)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    return lv_malloc_tier_core(size, tier);
+#else
+    LV_UNUSED(tier);
+    return lv_malloc_core(size);
+#endif
+}
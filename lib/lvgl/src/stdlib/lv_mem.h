@@ -29,6 +29,18 @@ extern "C" {
 
 typedef void * lv_mem_pool_t;
 
+/**
+ * Memory tiers of the builtin heap. Each tier is a separate TLSF instance built from the pools
+ * added to it, e.g. a small internal RAM pool for the frequent small allocations and a large
+ * external RAM pool for the big buffers.
+ */
+typedef enum {
+    LV_MEM_TIER_FAST,   /**< The `LV_MEM_SIZE` work memory and the pools added with `lv_mem_add_pool()`*/
+    LV_MEM_TIER_LARGE,  /**< Large and slower memory, e.g. external SDRAM*/
+    LV_MEM_TIER_CNT,
+    LV_MEM_TIER_AUTO = LV_MEM_TIER_CNT, /**< LARGE from `LV_MEM_LARGE_SIZE_MIN` bytes if it has a pool, else FAST*/
+} lv_mem_tier_t;
+
 /**
  * Heap information structure.
  */
@@ -61,6 +73,16 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes);
 
 void lv_mem_remove_pool(lv_mem_pool_t pool);
 
+/**
+ * Add a memory pool to a tier of the builtin heap.
+ * With the other heaps it is the same as `lv_mem_add_pool()`.
+ * @param mem       start of the memory
+ * @param bytes     size of the memory
+ * @param tier      `LV_MEM_TIER_FAST` or `LV_MEM_TIER_LARGE`
+ * @return          the new pool or NULL on failure
+ */
+lv_mem_pool_t lv_mem_add_pool_to_tier(void * mem, size_t bytes, lv_mem_tier_t tier);
+
 /**
  * Allocate memory dynamically
  * @param size requested size in bytes
@@ -68,6 +90,15 @@ void lv_mem_remove_pool(lv_mem_pool_t pool);
  */
 void * lv_malloc(size_t size);
 
+/**
+ * Allocate memory dynamically, preferably from a tier. When the tier is full (or has no pool)
+ * the other tier is used. `lv_realloc()` keeps the memory in its tier when it can.
+ * @param size      requested size in bytes
+ * @param tier      the preferred tier, `LV_MEM_TIER_AUTO` to choose by size like `lv_malloc()`
+ * @return          pointer to allocated uninitialized memory, or NULL on failure
+ */
+void * lv_malloc_tier(size_t size, lv_mem_tier_t tier);
+
 /**
  * Allocate zeroed memory dynamically
  * @param size requested size in bytes
@@ -96,6 +127,13 @@ void * lv_realloc(void * data_p, size_t new_size);
  */
 void * lv_malloc_core(size_t size);
 
+/**
+ * Used internally by the builtin heap to `malloc` from a tier
+ * @param size      size in bytes to `malloc`
+ * @param tier      the preferred tier
+ */
+void * lv_malloc_tier_core(size_t size, lv_mem_tier_t tier);
+
 /**
  * Used internally to execute a plain `free` operation
  * @param p      memory address to free
@@ -115,6 +153,13 @@ void * lv_realloc_core(void * p, size_t new_size);
  */
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p);
 
+/**
+ * Used internally by lv_mem_monitor_tier() to gather the state of a tier of the builtin heap.
+ * @param tier       the tier to analyze
+ * @param mon_p      pointer to lv_mem_monitor_t object to be populated.
+ */
+void lv_mem_monitor_tier_core(lv_mem_tier_t tier, lv_mem_monitor_t * mon_p);
+
 lv_result_t lv_mem_test_core(void);
 
 /**
@@ -130,6 +175,15 @@ lv_result_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Give information about one tier of the builtin heap.
+ * With the other heaps `LV_MEM_TIER_FAST` gives the whole heap and `LV_MEM_TIER_LARGE` nothing.
+ * @param tier  `LV_MEM_TIER_FAST` or `LV_MEM_TIER_LARGE`
+ * @param mon_p pointer to a lv_mem_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_mem_monitor_tier(lv_mem_tier_t tier, lv_mem_monitor_t * mon_p);
+
 /**********************
  *      MACROS
  **********************/
@@ -162,7 +162,8 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
             label->text = NULL;
         }
 
-        label->text = lv_malloc(text_len);
+        /*Texts are only read when drawn, keep the fast memory for the objects*/
+        label->text = lv_malloc_tier(text_len, LV_MEM_TIER_LARGE);
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
 
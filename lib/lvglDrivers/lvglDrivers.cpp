@@ -2,60 +2,382 @@
 #include "lv_conf.h"
 #include "stm32746g_discovery_lcd.h"
 #include "stm32746g_discovery_ts.h"
+#include "interrupt.h"
+#include "taskProfiler.h"
+#if LV_USE_DRAW_DMA2D
+#include "src/draw/st/dma2d/lv_draw_dma2d.h"
+#endif
+
+#define LCD_WIDTH 480
+#define LCD_HEIGHT 272
+
+// While a finger is down the touch controller is read at this period, until it is lifted
+#define TOUCH_POLL_MS 15
+
+// Touch points waiting for the LVGL input device
+#define TOUCH_QUEUE_SIZE 8
+
+// The large LVGL memory tier (layers, decoded images, label texts) is in the SDRAM after the framebuffers
+// (two 480x272x4 at most). The small objects stay in the LV_MEM_SIZE pool in internal RAM.
+#ifndef LVGL_SDRAM_HEAP_ADDRESS
+#define LVGL_SDRAM_HEAP_ADDRESS (LCD_FB_START_ADDRESS + 0x200000)
+#endif
+#define LVGL_SDRAM_HEAP_SIZE LV_MEM_POOL_EXPAND_SIZE
+
+// The LTDC layer uses the LVGL color format, so the flush never converts pixels
+#if LV_COLOR_DEPTH == 16
+typedef uint16_t LcdPixel;
+#elif LV_COLOR_DEPTH == 32
+typedef uint32_t LcdPixel;
+#else
+#error "The LCD driver supports LV_COLOR_DEPTH 16 (RGB565) and 32 (XRGB8888) only"
+#endif
+
+static void lvglAddSdramHeap(void)
+{
+    // The SDRAM is a Device memory by default: uncached, and every unaligned access faults.
+    // The DMA2D draw unit cleans and invalidates the cache around its transfers.
+    static_assert(LVGL_SDRAM_HEAP_SIZE == 2 * 1024 * 1024, "the MPU region is 2 MB");
+    MPU_Region_InitTypeDef region = {};
+    region.Enable = MPU_REGION_ENABLE;
+    region.Number = MPU_REGION_NUMBER7;
+    region.BaseAddress = LVGL_SDRAM_HEAP_ADDRESS;
+    region.Size = MPU_REGION_SIZE_2MB;
+    region.SubRegionDisable = 0;
+    region.TypeExtField = MPU_TEX_LEVEL1;
+    region.AccessPermission = MPU_REGION_FULL_ACCESS;
+    region.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+    region.IsShareable = MPU_ACCESS_NOT_SHAREABLE;
+    region.IsCacheable = MPU_ACCESS_CACHEABLE;
+    region.IsBufferable = MPU_ACCESS_BUFFERABLE;
+
+    HAL_MPU_Disable();
+    HAL_MPU_ConfigRegion(&region);
+    HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+
+    if (!lv_mem_add_pool_to_tier((void *)LVGL_SDRAM_HEAP_ADDRESS, LVGL_SDRAM_HEAP_SIZE, LV_MEM_TIER_LARGE))
+    {
+        Serial.println("No SDRAM heap");
+    }
+}
+
+static SemaphoreHandle_t lvglWakeSemaphore;
+
+static void lvglResume(void *data)
+{
+    // A timer was created or resumed, maybe by another task (touch, invalidation): run the handler now
+    xSemaphoreGive(lvglWakeSemaphore);
+}
 
 static void lvglTask(void *pvParameters)
 {
     while (1)
     {
+        // Sleep until the next timer is due, or forever when all of them are paused (a still menu).
+        // With the tickless idle the MCU sleeps too when no other task has work.
         uint32_t time_till_next = lv_timer_handler();
-        vTaskDelay(pdMS_TO_TICKS(time_till_next));
+        TickType_t ticks = time_till_next == LV_NO_TIMER_READY ? portMAX_DELAY : pdMS_TO_TICKS(time_till_next);
+        xSemaphoreTake(lvglWakeSemaphore, ticks);
+    }
+}
+
+static lv_display_t *flushDisplay;
+static SemaphoreHandle_t flushSemaphore;
+static volatile bool flushBusy = false;
+
+static void flushDone(void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    flushBusy = false;
+    lv_display_flush_ready(flushDisplay);
+    xSemaphoreGiveFromISR(flushSemaphore, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+static void cleanDCache(const void *addr, uint32_t size)
+{
+    // The DMA2D and the LTDC read from memory: write back what is still in the D-cache
+    if (SCB->CCR & SCB_CCR_DC_Msk)
+    {
+        uint32_t start = (uint32_t)addr & ~31UL;
+        uint32_t end = (uint32_t)addr + size;
+        SCB_CleanDCache_by_Addr((uint32_t *)start, end - start);
+    }
+}
+
+extern "C" void LTDC_IRQHandler(void)
+{
+    BSP_LCD_LTDC_IRQHandler();
+}
+
+extern "C" void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+#if LVGL_DRIVERS_DOUBLE_FB
+    // The new framebuffer is on screen, the previous one can be rendered into.
+    // The sprite also reloads the LTDC configuration, only a pending flush is done here.
+    if (flushBusy)
+    {
+        flushDone();
     }
+#endif
 }
 
+#if LVGL_DRIVERS_DOUBLE_FB
+
+// Two full framebuffers in SDRAM, the LTDC scans out one while LVGL renders into the other
+#define LCD_FB_SIZE (LCD_WIDTH * LCD_HEIGHT * sizeof(LcdPixel))
+#define LCD_FB0_ADDRESS LCD_FB_START_ADDRESS
+#define LCD_FB1_ADDRESS (LCD_FB_START_ADDRESS + LCD_FB_SIZE)
+
+static void lcdMapFramebuffers(void)
+{
+    // LVGL blends straight into the framebuffers, which are a Device memory by default: uncached,
+    // and every unaligned access faults. They are mapped as a Normal write-through memory, below the
+    // SDRAM heap region: the LTDC always reads what the CPU wrote, also the sync areas LVGL copies
+    // from the other buffer outside of the flushed areas, and the reads for the blends are cached.
+    static_assert(2 * LCD_FB_SIZE <= 1024 * 1024, "the MPU region is 1 MB");
+    static_assert(LCD_FB_START_ADDRESS + 1024 * 1024 <= LVGL_SDRAM_HEAP_ADDRESS, "overlaps the SDRAM heap");
+    MPU_Region_InitTypeDef region = {};
+    region.Enable = MPU_REGION_ENABLE;
+    region.Number = MPU_REGION_NUMBER6;
+    region.BaseAddress = LCD_FB_START_ADDRESS;
+    region.Size = MPU_REGION_SIZE_1MB;
+    region.SubRegionDisable = 0;
+    region.TypeExtField = MPU_TEX_LEVEL0;
+    region.AccessPermission = MPU_REGION_FULL_ACCESS;
+    region.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+    region.IsShareable = MPU_ACCESS_NOT_SHAREABLE;
+    region.IsCacheable = MPU_ACCESS_CACHEABLE;
+    region.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+
+    HAL_MPU_Disable();
+    HAL_MPU_ConfigRegion(&region);
+    HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+}
+
+#if LV_USE_DRAW_DMA2D && LV_USE_DRAW_DMA2D_INTERRUPT
+extern "C" void DMA2D_IRQHandler(void)
+{
+    // Only the LVGL draw unit uses the DMA2D, the flush is done by the LTDC
+    lv_draw_dma2d_transfer_complete_interrupt_handler();
+}
+#endif
+
 static void my_flush_cb(lv_display_t *display, const lv_area_t *area, uint8_t *px_map)
 {
-    uint32_t *buf = (uint32_t *)px_map;
-    int32_t x, y;
-    for (y = area->y1; y <= area->y2; y++)
+    // px_map is the whole framebuffer, the area was rendered in place.
+    // Nothing is dirty with the write-through mapping, the clean costs a few cycles per line.
+    uint32_t lineSize = LCD_WIDTH * sizeof(LcdPixel);
+    cleanDCache(px_map + area->y1 * lineSize, lv_area_get_height(area) * lineSize);
+
+    if (!lv_display_flush_is_last(display))
     {
-        for (x = area->x1; x <= area->x2; x++)
-        {
-            BSP_LCD_DrawPixel(x, y, *buf);
-            buf++;
-        }
+        lv_display_flush_ready(display);
+        return;
     }
 
-    // IMPORTANT!!!
-    // Inform LVGL that you are ready with the flushing and buf is not used anymore
-    lv_display_flush_ready(display);
+    // Show the rendered framebuffer from the next vertical blanking
+    flushDisplay = display;
+    flushBusy = true;
+    BSP_LCD_SetLayerAddress_NoReload(0, (uint32_t)px_map);
+    BSP_LCD_Reload(LCD_RELOAD_VERTICAL_BLANKING);
+
+    // lv_display_flush_ready() is called from the LTDC reload interrupt
 }
 
-static void my_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+#else
+
+extern "C" void DMA2D_IRQHandler(void)
+{
+#if LV_USE_DRAW_DMA2D && LV_USE_DRAW_DMA2D_INTERRUPT
+    // The DMA2D is shared with the LVGL draw unit, which renders the next area into the other buffer
+    // while a flush copies the previous one. While flushBusy is set the interrupt is the flush's one:
+    // - a flush starts once its area is rendered, when no draw unit transfer or interrupt is left;
+    // - the draw unit starts a transfer only after wait_idle() in lv_draw_dma2d.c has seen the flush
+    //   transfer done and its interrupt served, i.e. after flushDone() has cleared flushBusy.
+    // Keep that wait, and keep flushDone() clearing flushBusy in the interrupt that ends the flush.
+    if (!flushBusy)
+    {
+        lv_draw_dma2d_transfer_complete_interrupt_handler();
+        return;
+    }
+#endif
+    BSP_LCD_DMA2D_IRQHandler();
+}
+
+extern "C" void BSP_LCD_DMA2D_TransferCpltCallback(void)
 {
-    TS_StateTypeDef TS_State;
-    BSP_TS_GetState(&TS_State);
+    flushDone();
+}
+
+static void my_flush_cb(lv_display_t *display, const lv_area_t *area, uint8_t *px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+
+    cleanDCache(px_map, w * h * sizeof(LcdPixel));
 
-    if (TS_State.touchDetected != 0)
+    flushDisplay = display;
+    flushBusy = true;
+    if (BSP_LCD_CopyBuffer_IT(0, px_map, area->x1, area->y1, w, h) != LCD_OK)
     {
-        data->point.x = TS_State.touchX[0];
-        data->point.y = TS_State.touchY[0];
-        data->state = LV_INDEV_STATE_PRESSED;
+        // The transfer could not start, nothing to wait for
+        flushBusy = false;
+        lv_display_flush_ready(display);
     }
-    else
+
+    // lv_display_flush_ready() is called from the DMA2D transfer complete interrupt
+}
+
+#endif // LVGL_DRIVERS_DOUBLE_FB
+
+static void my_flush_wait_cb(lv_display_t *display)
+{
+    // Sleep until the flush is done instead of spinning on the flushing flag
+    while (flushBusy)
     {
-        data->state = LV_INDEV_STATE_RELEASED;
+        xSemaphoreTake(flushSemaphore, portMAX_DELAY);
     }
 }
 
+// The sprite is always ARGB8888 so that its antialiased edges blend with layer 0
+static uint32_t hwSpriteBuffer[HW_SPRITE_MAX_SIZE * HW_SPRITE_MAX_SIZE];
+static lv_draw_buf_t hwSpriteDrawBuf;
+static int32_t hwSpriteX = 0;
+static int32_t hwSpriteY = 0;
+static bool hwSpriteVisible = false;
+
+static void hwSpriteApply(void)
+{
+    int32_t w = hwSpriteDrawBuf.header.w;
+    int32_t h = hwSpriteDrawBuf.header.h;
+
+    // The layer window must stay inside the screen
+    int32_t x = LV_CLAMP(0, hwSpriteX, LCD_WIDTH - w);
+    int32_t y = LV_CLAMP(0, hwSpriteY, LCD_HEIGHT - h);
+
+    // Only the shadow registers are written, the LTDC switches on the next vertical blanking
+    BSP_LCD_SetLayerWindow_NoReload(1, x, y, w, h);
+    BSP_LCD_SetLayerVisible_NoReload(1, hwSpriteVisible ? ENABLE : DISABLE);
+    BSP_LCD_Reload(LCD_RELOAD_VERTICAL_BLANKING);
+}
+
+bool hwSpriteSetContent(lv_obj_t *obj)
+{
+    lv_obj_update_layout(obj);
+    if (lv_snapshot_take_to_draw_buf(obj, LV_COLOR_FORMAT_ARGB8888, &hwSpriteDrawBuf) != LV_RESULT_OK)
+    {
+        return false;
+    }
+
+    cleanDCache(hwSpriteBuffer, hwSpriteDrawBuf.header.h * hwSpriteDrawBuf.header.stride);
+    hwSpriteApply();
+    return true;
+}
+
+void hwSpriteSetPos(int32_t x, int32_t y)
+{
+    if (x == hwSpriteX && y == hwSpriteY)
+    {
+        return;
+    }
+
+    hwSpriteX = x;
+    hwSpriteY = y;
+    hwSpriteApply();
+}
+
+void hwSpriteSetVisible(bool visible)
+{
+    if (visible == hwSpriteVisible)
+    {
+        return;
+    }
+
+    hwSpriteVisible = visible;
+    hwSpriteApply();
+}
+
+struct TouchPoint
+{
+    int16_t x;
+    int16_t y;
+    bool pressed;
+};
+
+static lv_indev_t *touchIndev;
+static QueueHandle_t touchQueue;
+static TaskHandle_t touchTaskHandle;
+static TouchPoint lastTouch = {0, 0, false};
+
+static void touchIsr(void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(touchTaskHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+static void touchTask(void *pvParameters)
+{
+    while (1)
+    {
+        // No I2C traffic until the controller signals a touch
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Follow the finger until it is lifted
+        TouchPoint point;
+        do
+        {
+            TS_StateTypeDef TS_State;
+            BSP_TS_GetState(&TS_State);
+
+            point.pressed = TS_State.touchDetected != 0;
+            point.x = point.pressed ? TS_State.touchX[0] : lastTouch.x;
+            point.y = point.pressed ? TS_State.touchY[0] : lastTouch.y;
+            // The read right after pops it, so the queue never fills and a release is never lost
+            xQueueSend(touchQueue, &point, portMAX_DELAY);
+            lv_lock();
+            lv_indev_read(touchIndev);
+            lv_unlock();
+
+            if (point.pressed)
+            {
+                vTaskDelay(pdMS_TO_TICKS(TOUCH_POLL_MS));
+            }
+        } while (point.pressed);
+    }
+}
+
+static void my_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    // Called by lv_indev_read() from the touch task, and by LVGL while pressed (long press,
+    // scroll): the last point stays valid until a new one is queued
+    xQueueReceive(touchQueue, &lastTouch, 0);
+
+    data->point.x = lastTouch.x;
+    data->point.y = lastTouch.y;
+    data->state = lastTouch.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
 void setup()
 {
     Serial.begin(115200);
     Serial.println("Start");
 
     BSP_LCD_Init();
+#if LV_COLOR_DEPTH == 16
+    BSP_LCD_LayerRgb565Init(0, LCD_FB_START_ADDRESS);
+#else
     BSP_LCD_LayerDefaultInit(0, LCD_FB_START_ADDRESS);
+#endif
+
+    // Layer 1 shows the sprite, transparent and hidden until it gets a content
+    BSP_LCD_LayerWindowInit(1, (uint32_t)hwSpriteBuffer, 0, 0, HW_SPRITE_MAX_SIZE, HW_SPRITE_MAX_SIZE);
+    BSP_LCD_SetLayerVisible(1, DISABLE);
 
-    BSP_TS_Init(480, 272);
+    BSP_TS_Init(LCD_WIDTH, LCD_HEIGHT);
 
     lv_init();
 
@@ -63,24 +385,61 @@ void setup()
         Serial.printf("%s", buf);
     });
 
-    lv_display_t *display = lv_display_create(480, 272);
+    // The SDRAM was initialized by BSP_LCD_Init()
+#if LVGL_DRIVERS_DOUBLE_FB
+    lcdMapFramebuffers();
+#endif
+    lvglAddSdramHeap();
+
+    lv_display_t *display = lv_display_create(LCD_WIDTH, LCD_HEIGHT);
+
+    lv_draw_buf_init(&hwSpriteDrawBuf, HW_SPRITE_MAX_SIZE, HW_SPRITE_MAX_SIZE, LV_COLOR_FORMAT_ARGB8888,
+                     LV_STRIDE_AUTO, hwSpriteBuffer, sizeof(hwSpriteBuffer));
 
+    flushSemaphore = xSemaphoreCreateBinary();
     lv_display_set_flush_cb(display, my_flush_cb);
+    lv_display_set_flush_wait_cb(display, my_flush_wait_cb);
 
-    static uint32_t buf[480 * 272 / 10];
+#if LVGL_DRIVERS_DOUBLE_FB
+    // FB0 is on screen after the layer init, so LVGL starts rendering into FB1.
+    // LVGL copies the areas drawn in the previous frame into the other buffer before
+    // rendering (sync areas), so partial invalidation keeps working.
+    lv_display_set_buffers(display, (void *)LCD_FB1_ADDRESS, (void *)LCD_FB0_ADDRESS, LCD_FB_SIZE,
+                           LV_DISPLAY_RENDER_MODE_DIRECT);
+#else
+    // Two buffers: LVGL renders into one while the DMA2D copies the other.
+    // Each one takes the same internal RAM whatever the color depth, so RGB565 gets twice the lines.
+    static LcdPixel buf1[LCD_WIDTH * LCD_HEIGHT / 10 * sizeof(uint32_t) / sizeof(LcdPixel)];
+    static LcdPixel buf2[LCD_WIDTH * LCD_HEIGHT / 10 * sizeof(uint32_t) / sizeof(LcdPixel)];
 
-    lv_display_set_buffers(display, buf, NULL, sizeof(buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_buffers(display, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+#endif
 
-    lv_indev_t *indev = lv_indev_create();
-    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    lv_indev_set_read_cb(indev, my_read_cb);
+    // The touch screen is only read after its interrupt, LVGL does not poll it
+    touchQueue = xQueueCreate(TOUCH_QUEUE_SIZE, sizeof(TouchPoint));
+    touchIndev = lv_indev_create();
+    lv_indev_set_type(touchIndev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(touchIndev, my_read_cb);
+    lv_indev_set_mode(touchIndev, LV_INDEV_MODE_EVENT);
+
+    xTaskCreate(touchTask, "touch", 4096, NULL, osPriorityAboveNormal, &touchTaskHandle);
+    BSP_TS_ITConfig();
+    // The EXTI handlers belong to the Arduino core, the callback is registered there
+    stm32_interrupt_enable(TS_INT_GPIO_PORT, TS_INT_PIN, touchIsr, GPIO_MODE_IT_RISING);
+
+#if TASK_PROFILING
+    taskProfilerBegin();
+#endif
 
     lv_tick_set_cb(xTaskGetTickCount);
 
+    lvglWakeSemaphore = xSemaphoreCreateBinary();
+    lv_timer_handler_set_resume_cb(lvglResume, NULL);
+
     mySetup();
 
-    xTaskCreate(lvglTask, NULL, 16384, NULL, osPriorityNormal, NULL);
-    // xTaskCreate(myTask, NULL, 16384, NULL, osPriorityNormal, NULL);
+    xTaskCreate(lvglTask, "lvgl", 16384, NULL, osPriorityNormal, NULL);
+    xTaskCreate(myTask, "game", 4096, NULL, MY_TASK_PRIORITY, NULL);
 
     vTaskStartScheduler();
     Serial.println("Insufficient RAM");
@@ -6,6 +6,31 @@
 #include <Arduino.h>
 #include "STM32FreeRTOS.h"
 
+// 0: partial buffers in internal RAM copied to the framebuffer by the DMA2D
+// 1: two full framebuffers in SDRAM rendered in direct mode and swapped on vertical blanking
+#ifndef LVGL_DRIVERS_DOUBLE_FB
+#define LVGL_DRIVERS_DOUBLE_FB 0
+#endif
+
+// Hardware sprite: an LVGL object rendered once into a small ARGB8888 buffer shown by the
+// second LTDC layer, above the LVGL screen. Moving it only reprograms the layer window, so
+// LVGL has nothing to redraw. hwSpriteSetContent() renders with LVGL, so it needs the LVGL task
+// to be running: it can't be called from mySetup().
+#define HW_SPRITE_MAX_SIZE 64
+
+bool hwSpriteSetContent(lv_obj_t *obj);
+void hwSpriteSetPos(int32_t x, int32_t y);
+void hwSpriteSetVisible(bool visible);
+
+// Threads: the LVGL task renders, it runs the LVGL timers and event callbacks. myTask() runs the
+// game at its own fixed rate in a task above it, so a long render never delays it. myTask() must
+// not wait for the LVGL lock: it publishes its state through a TripleBuffer (tripleBuffer.h) that
+// an LVGL timer reads, and the UI sends it commands through a FreeRTOS queue. Other tasks may call
+// LVGL between lv_lock() and lv_unlock().
+// The LVGL task sleeps until its next timer, and the MCU with it when every task is blocked (tickless
+// idle): pause the timers and block the tasks which have nothing to do while a menu is shown.
+#define MY_TASK_PRIORITY osPriorityHigh
+
 void mySetup();
 void myTask(void *pvParameters);
 
@@ -0,0 +1,51 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Latest value passed from one writer task to one reader task, without a lock: the writer
+// fills its own buffer and swaps it with the middle one, the reader takes the middle one when
+// it is newer. Neither side ever waits for the other, the reader may skip values.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Buffer to fill before publish(). Its content is stale, every field must be written.
+    T *writeBuffer()
+    {
+        return &_buffers[_back];
+    }
+
+    void publish()
+    {
+        uint8_t old = _middle.exchange(_back | FRESH, std::memory_order_acq_rel);
+        _back = old & INDEX;
+    }
+
+    // Latest published value, the same one as the previous call when nothing new was published.
+    // Returns NULL until the first publish().
+    const T *read()
+    {
+        if (_middle.load(std::memory_order_relaxed) & FRESH)
+        {
+            uint8_t old = _middle.exchange(_front, std::memory_order_acq_rel);
+            _front = old & INDEX;
+            _valid = true;
+        }
+        return _valid ? &_buffers[_front] : NULL;
+    }
+
+private:
+    static const uint8_t INDEX = 0x03;
+    static const uint8_t FRESH = 0x04;
+
+    T _buffers[3];
+    std::atomic<uint8_t> _middle{1};
+    uint8_t _back = 0;  // writer only
+    uint8_t _front = 2; // reader only
+    bool _valid = false;
+};
+
+#endif // TRIPLE_BUFFER_H
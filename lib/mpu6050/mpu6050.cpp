@@ -0,0 +1,176 @@
+#include "mpu6050.h"
+#include <Arduino.h>
+#include "spscRing.h"
+#include "i2cBus.h"
+#include "STM32FreeRTOS.h"
+
+#define MPU6050_REG_SMPLRT_DIV 0x19
+#define MPU6050_REG_CONFIG 0x1A
+#define MPU6050_REG_FIFO_EN 0x23
+#define MPU6050_REG_INT_ENABLE 0x38
+#define MPU6050_REG_ACCEL_XOUT_H 0x3B
+#define MPU6050_REG_USER_CTRL 0x6A
+#define MPU6050_REG_PWR_MGMT_1 0x6B
+#define MPU6050_REG_FIFO_COUNTH 0x72
+#define MPU6050_REG_FIFO_R_W 0x74
+
+#define MPU6050_FIFO_EN_GYRO_XYZ 0x70
+#define MPU6050_FIFO_EN_ACCEL 0x08
+#define MPU6050_INT_DATA_RDY_EN 0x01
+#define MPU6050_USER_CTRL_FIFO_EN 0x40
+#define MPU6050_USER_CTRL_FIFO_RESET 0x04
+
+// Size of the sensor FIFO, and of one sample in it: accelerometer then gyro, big endian
+#define MPU6050_FIFO_SIZE 1024
+#define MPU6050_FIFO_SAMPLE_SIZE 12
+
+// Samples read by one burst, the rest stays in the FIFO for the next period
+#define MPU6050_FIFO_MAX_BURST 16
+
+static SpscRing<Mpu6050Sample, MPU6050_RING_SIZE> sampleRing;
+static volatile uint32_t overruns = 0;
+
+static TaskHandle_t sensorTaskHandle;
+static uint8_t rxBuffer[MPU6050_FIFO_MAX_BURST * MPU6050_FIFO_SAMPLE_SIZE];
+
+static bool writeRegister(uint8_t reg, uint8_t value)
+{
+    return i2cBusWrite(I2C_BUS_EXT, I2C_PRIORITY_INPUT, MPU6050_ADDR << 1, reg, I2C_MEMADD_SIZE_8BIT, &value, 1) ==
+           HAL_OK;
+}
+
+static bool readRegisters(uint8_t reg, uint8_t *data, uint16_t size)
+{
+    // The task sleeps during the transfer, queued with the touch screen reads before the EEPROM
+    return i2cBusRead(I2C_BUS_EXT, I2C_PRIORITY_INPUT, MPU6050_ADDR << 1, reg, I2C_MEMADD_SIZE_8BIT, data, size) ==
+           HAL_OK;
+}
+
+static void pushSample(const uint8_t *accel, const uint8_t *gyro, uint32_t timeUs)
+{
+    Mpu6050Sample sample;
+    sample.accX = (int16_t)(accel[0] << 8 | accel[1]);
+    sample.accY = (int16_t)(accel[2] << 8 | accel[3]);
+    sample.accZ = (int16_t)(accel[4] << 8 | accel[5]);
+    sample.gyroX = (int16_t)(gyro[0] << 8 | gyro[1]);
+    sample.gyroY = (int16_t)(gyro[2] << 8 | gyro[3]);
+    sample.gyroZ = (int16_t)(gyro[4] << 8 | gyro[5]);
+    sample.timeUs = timeUs;
+
+    if (!sampleRing.push(sample))
+    {
+        overruns++;
+    }
+}
+
+#if MPU6050_USE_FIFO
+
+static void resetFifo(void)
+{
+    writeRegister(MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN | MPU6050_USER_CTRL_FIFO_RESET);
+}
+
+static void sensorTask(void *pvParameters)
+{
+    TickType_t lastWake = xTaskGetTickCount();
+
+    while (1)
+    {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(MPU6050_FIFO_PERIOD_MS));
+
+        uint8_t countBytes[2];
+        if (!readRegisters(MPU6050_REG_FIFO_COUNTH, countBytes, sizeof(countBytes)))
+        {
+            continue;
+        }
+
+        uint16_t count = countBytes[0] << 8 | countBytes[1];
+        if (count >= MPU6050_FIFO_SIZE || count % MPU6050_FIFO_SAMPLE_SIZE != 0)
+        {
+            // The FIFO overflowed and lost the sample boundaries, start again from an empty one
+            resetFifo();
+            overruns++;
+            continue;
+        }
+
+        int samples = count / MPU6050_FIFO_SAMPLE_SIZE;
+        if (samples > MPU6050_FIFO_MAX_BURST)
+        {
+            samples = MPU6050_FIFO_MAX_BURST;
+        }
+        if (samples == 0 || !readRegisters(MPU6050_REG_FIFO_R_W, rxBuffer, samples * MPU6050_FIFO_SAMPLE_SIZE))
+        {
+            continue;
+        }
+
+        // The samples are evenly spaced, the last one is the most recent
+        uint32_t now = micros();
+        for (int i = 0; i < samples; i++)
+        {
+            const uint8_t *data = &rxBuffer[i * MPU6050_FIFO_SAMPLE_SIZE];
+            pushSample(&data[0], &data[6], now - (samples - 1 - i) * (1000000 / MPU6050_SAMPLE_RATE_HZ));
+        }
+    }
+}
+
+#else
+
+static void dataReadyIsr(void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(sensorTaskHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+static void sensorTask(void *pvParameters)
+{
+    while (1)
+    {
+        // A timeout also reads, in case INT is not wired
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MPU6050_INT_TIMEOUT_MS));
+
+        // Accelerometer, temperature and gyro registers in one read
+        if (readRegisters(MPU6050_REG_ACCEL_XOUT_H, rxBuffer, 14))
+        {
+            pushSample(&rxBuffer[0], &rxBuffer[8], micros());
+        }
+    }
+}
+
+#endif // MPU6050_USE_FIFO
+
+bool mpu6050Begin(void)
+{
+    i2cBusBegin(I2C_BUS_EXT);
+
+    bool ok = writeRegister(MPU6050_REG_PWR_MGMT_1, 0);
+    ok = ok && writeRegister(MPU6050_REG_CONFIG, MPU6050_DLPF_CFG);
+    ok = ok && writeRegister(MPU6050_REG_SMPLRT_DIV, MPU6050_SAMPLE_RATE_DIV);
+#if MPU6050_USE_FIFO
+    ok = ok && writeRegister(MPU6050_REG_FIFO_EN, MPU6050_FIFO_EN_ACCEL | MPU6050_FIFO_EN_GYRO_XYZ);
+    ok = ok && writeRegister(MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN | MPU6050_USER_CTRL_FIFO_RESET);
+#else
+    ok = ok && writeRegister(MPU6050_REG_INT_ENABLE, MPU6050_INT_DATA_RDY_EN);
+#endif
+
+    xTaskCreate(sensorTask, "mpu6050", 512, NULL, osPriorityAboveNormal, &sensorTaskHandle);
+
+#if !MPU6050_USE_FIFO
+    // INT pulses high for 50 us on each new sample
+    pinMode(MPU6050_INT_PIN, INPUT);
+    attachInterrupt(digitalPinToInterrupt(MPU6050_INT_PIN), dataReadyIsr, RISING);
+#endif
+
+    return ok;
+}
+
+bool mpu6050Read(Mpu6050Sample *sample)
+{
+    return sampleRing.pop(sample);
+}
+
+uint32_t mpu6050Overruns(void)
+{
+    return overruns;
+}
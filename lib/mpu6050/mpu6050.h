@@ -0,0 +1,63 @@
+#ifndef MPU6050_H
+#define MPU6050_H
+
+#include <stdint.h>
+
+#define MPU6050_ADDR 0x68
+
+// 1: the sensor stores its samples in its FIFO, which is drained by one burst read per period
+// 0: each sample is read on its data ready interrupt
+#ifndef MPU6050_USE_FIFO
+#define MPU6050_USE_FIFO 1
+#endif
+
+// Digital low pass filter (CONFIG register). 3: 44 Hz accelerometer and 42 Hz gyro bandwidth,
+// below the Nyquist frequency of the sample rate so fast vibrations don't alias into the tilt
+#ifndef MPU6050_DLPF_CFG
+#define MPU6050_DLPF_CFG 3
+#endif
+
+// Sample rate divider (SMPLRT_DIV register): 1 kHz / (1 + div) with the low pass filter enabled
+#ifndef MPU6050_SAMPLE_RATE_DIV
+#define MPU6050_SAMPLE_RATE_DIV 4
+#endif
+
+#define MPU6050_SAMPLE_RATE_HZ (1000 / (1 + MPU6050_SAMPLE_RATE_DIV))
+
+// Period of the FIFO burst reads, one game frame
+#define MPU6050_FIFO_PERIOD_MS 20
+
+// Arduino pin wired to the INT output of the MPU6050, pulsed when a new sample is ready
+#ifndef MPU6050_INT_PIN
+#define MPU6050_INT_PIN D2
+#endif
+
+// Without a data ready interrupt for this long the task reads anyway, so the sensor still works
+// (at a lower rate) when INT is not wired. Not used in FIFO mode.
+#define MPU6050_INT_TIMEOUT_MS 5
+
+// Samples buffered between the sensor task and the game, a few frames at the sensor rate
+#define MPU6050_RING_SIZE 64
+
+struct Mpu6050Sample
+{
+    int16_t accX;
+    int16_t accY;
+    int16_t accZ;
+    int16_t gyroX;
+    int16_t gyroY;
+    int16_t gyroZ;
+    uint32_t timeUs;
+};
+
+// Configures the sensor and starts the acquisition task. The samples are read through the shared
+// I2C scheduler (i2cBus), the task sleeps during the transfers. Call it from mySetup().
+bool mpu6050Begin(void);
+
+// Pops the oldest sample not read yet, returns false if there is none. Only one task may read.
+bool mpu6050Read(Mpu6050Sample *sample);
+
+// Number of samples dropped because the ring was full (nobody read them for too long)
+uint32_t mpu6050Overruns(void);
+
+#endif // MPU6050_H
@@ -0,0 +1,49 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Queue between one producer and one consumer, usable from a task or an interrupt without a lock:
+// only the producer writes head and only the consumer writes tail.
+template <typename T, uint32_t Size>
+class SpscRing
+{
+    static_assert((Size & (Size - 1)) == 0, "The size of the ring must be a power of two");
+
+public:
+    // Returns false if the ring is full, the item is dropped
+    bool push(const T &item)
+    {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == Size)
+        {
+            return false;
+        }
+
+        _items[head & (Size - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns false if the ring is empty
+    bool pop(T *item)
+    {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        *item = _items[tail & (Size - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T _items[Size];
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,220 @@
+#include "spriteField.h"
+
+static void drawEventCb(lv_event_t *e)
+{
+    SpriteField *field = (SpriteField *)lv_event_get_user_data(e);
+    lv_layer_t *layer = lv_event_get_layer(e);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    lv_obj_init_draw_rect_dsc(field->obj, LV_PART_ITEMS, &dsc);
+
+    lv_area_t coords;
+    lv_obj_get_coords(field->obj, &coords);
+
+    // One fill task per sprite rather than one custom task for the whole field: plain fills are
+    // taken by the DMA2D draw unit, which runs them while the CPU creates the next ones, and a
+    // custom task type would have to be drawn by the CPU. Only the sprites in the area being
+    // refreshed become draw tasks, a few per invalidated area since the areas follow the sprites
+    // that moved.
+    const lv_area_t *clip = &layer->_clip_area;
+    for (int i = 0; i < field->count; i++)
+    {
+        lv_area_t area;
+        area.x1 = coords.x1 + field->x[i];
+        area.y1 = coords.y1 + field->y[i];
+        area.x2 = area.x1 + field->spriteWidth - 1;
+        area.y2 = area.y1 + field->spriteHeight - 1;
+
+        if (area.x2 < clip->x1 || area.x1 > clip->x2 || area.y2 < clip->y1 || area.y1 > clip->y2)
+        {
+            continue;
+        }
+
+        lv_draw_rect(layer, &dsc, &area);
+    }
+}
+
+lv_obj_t *spriteFieldCreate(SpriteField *field, lv_obj_t *parent, int32_t spriteWidth, int32_t spriteHeight)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(obj, drawEventCb, LV_EVENT_DRAW_MAIN, field);
+
+    field->obj = obj;
+    field->spriteWidth = spriteWidth;
+    field->spriteHeight = spriteHeight;
+    field->count = 0;
+    return obj;
+}
+
+// Adds an area to the set, joining it with an overlapping area, or with the one that grows
+// the least once the set is full
+static void mergeArea(lv_area_t *areas, int *count, const lv_area_t *area)
+{
+    int best = -1;
+    uint32_t bestGrowth = UINT32_MAX;
+
+    for (int j = 0; j < *count; j++)
+    {
+        lv_area_t joined;
+        joined.x1 = LV_MIN(areas[j].x1, area->x1);
+        joined.y1 = LV_MIN(areas[j].y1, area->y1);
+        joined.x2 = LV_MAX(areas[j].x2, area->x2);
+        joined.y2 = LV_MAX(areas[j].y2, area->y2);
+
+        // Joining costs nothing more than drawing both areas separately
+        uint32_t growth = lv_area_get_size(&joined) - lv_area_get_size(&areas[j]);
+        if (growth <= lv_area_get_size(area))
+        {
+            areas[j] = joined;
+            return;
+        }
+
+        if (growth < bestGrowth)
+        {
+            bestGrowth = growth;
+            best = j;
+        }
+    }
+
+    if (*count < SPRITE_FIELD_MAX_AREAS)
+    {
+        areas[(*count)++] = *area;
+        return;
+    }
+
+    areas[best].x1 = LV_MIN(areas[best].x1, area->x1);
+    areas[best].y1 = LV_MIN(areas[best].y1, area->y1);
+    areas[best].x2 = LV_MAX(areas[best].x2, area->x2);
+    areas[best].y2 = LV_MAX(areas[best].y2, area->y2);
+}
+
+// Joining areas can make them overlap others: join again until no pair is worth joining
+static void mergeOverlaps(lv_area_t *areas, int *count)
+{
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (int j = 0; j < *count && !merged; j++)
+        {
+            for (int k = j + 1; k < *count; k++)
+            {
+                lv_area_t joined;
+                joined.x1 = LV_MIN(areas[j].x1, areas[k].x1);
+                joined.y1 = LV_MIN(areas[j].y1, areas[k].y1);
+                joined.x2 = LV_MAX(areas[j].x2, areas[k].x2);
+                joined.y2 = LV_MAX(areas[j].y2, areas[k].y2);
+
+                if (lv_area_get_size(&joined) <= lv_area_get_size(&areas[j]) + lv_area_get_size(&areas[k]))
+                {
+                    areas[j] = joined;
+                    areas[k] = areas[--(*count)];
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void spriteFieldSync(SpriteField *field, const float *x, const float *y, int count)
+{
+    if (count > SPRITE_FIELD_MAX_SPRITES)
+    {
+        count = SPRITE_FIELD_MAX_SPRITES;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_coords(field->obj, &coords);
+
+    lv_area_t areas[SPRITE_FIELD_MAX_AREAS];
+    int areaCount = 0;
+    int maxCount = LV_MAX(count, field->count);
+
+    for (int i = 0; i < maxCount; i++)
+    {
+        bool wasShown = i < field->count;
+        bool isShown = i < count;
+        int16_t newX = isShown ? (int16_t)x[i] : 0;
+        int16_t newY = isShown ? (int16_t)y[i] : 0;
+
+        if (wasShown && isShown && newX == field->x[i] && newY == field->y[i])
+        {
+            continue;
+        }
+
+        // The sprites move by a few pixels, the old and new positions are redrawn as one area
+        lv_area_t area;
+        if (wasShown && isShown)
+        {
+            area.x1 = LV_MIN(field->x[i], newX);
+            area.y1 = LV_MIN(field->y[i], newY);
+            area.x2 = LV_MAX(field->x[i], newX);
+            area.y2 = LV_MAX(field->y[i], newY);
+        }
+        else if (wasShown)
+        {
+            area.x1 = area.x2 = field->x[i];
+            area.y1 = area.y2 = field->y[i];
+        }
+        else
+        {
+            area.x1 = area.x2 = newX;
+            area.y1 = area.y2 = newY;
+        }
+        area.x2 += field->spriteWidth - 1;
+        area.y2 += field->spriteHeight - 1;
+
+        if (isShown)
+        {
+            field->x[i] = newX;
+            field->y[i] = newY;
+        }
+
+        // Sprites outside the object are not drawn
+        if (area.x2 >= 0 && area.y2 >= 0 && area.x1 < lv_area_get_width(&coords) && area.y1 < lv_area_get_height(&coords))
+        {
+            mergeArea(areas, &areaCount, &area);
+        }
+    }
+    field->count = count;
+
+    mergeOverlaps(areas, &areaCount);
+
+    // With many sprites the areas can cover more than their bounding box: redraw it once instead
+    if (areaCount > 1)
+    {
+        lv_area_t bounds = areas[0];
+        uint32_t total = 0;
+        for (int j = 0; j < areaCount; j++)
+        {
+            bounds.x1 = LV_MIN(bounds.x1, areas[j].x1);
+            bounds.y1 = LV_MIN(bounds.y1, areas[j].y1);
+            bounds.x2 = LV_MAX(bounds.x2, areas[j].x2);
+            bounds.y2 = LV_MAX(bounds.y2, areas[j].y2);
+            total += lv_area_get_size(&areas[j]);
+        }
+
+        if (total >= lv_area_get_size(&bounds))
+        {
+            areas[0] = bounds;
+            areaCount = 1;
+        }
+    }
+
+    for (int j = 0; j < areaCount; j++)
+    {
+        lv_area_move(&areas[j], coords.x1, coords.y1);
+        lv_obj_invalidate_area(field->obj, &areas[j]);
+    }
+}
+
+void spriteFieldClear(SpriteField *field)
+{
+    spriteFieldSync(field, NULL, NULL, 0);
+}
@@ -0,0 +1,41 @@
+#ifndef SPRITE_FIELD_H
+#define SPRITE_FIELD_H
+
+#include "lvgl.h"
+
+// Capacity of a field, can be raised from the build flags
+#ifndef SPRITE_FIELD_MAX_SPRITES
+#define SPRITE_FIELD_MAX_SPRITES 256
+#endif
+
+// Maximum number of areas invalidated by one spriteFieldSync(), half of LV_INV_BUF_SIZE
+// so the rest of the UI can still invalidate its own areas without a full screen refresh
+#define SPRITE_FIELD_MAX_AREAS 16
+
+// Many same-sized rectangles drawn by a single object: one draw handler and one tree node
+// instead of one LVGL object per sprite, each sprite in the refreshed area is one draw task.
+// The look of the sprites comes from the LV_PART_ITEMS styles of the object (background,
+// border, radius...).
+struct SpriteField
+{
+    lv_obj_t *obj;
+    int32_t spriteWidth;
+    int32_t spriteHeight;
+
+    // Positions relative to the object, as drawn by the last refresh
+    int16_t x[SPRITE_FIELD_MAX_SPRITES];
+    int16_t y[SPRITE_FIELD_MAX_SPRITES];
+    int count;
+};
+
+// Creates a transparent, non clickable object covering the parent to draw the sprites in
+lv_obj_t *spriteFieldCreate(SpriteField *field, lv_obj_t *parent, int32_t spriteWidth, int32_t spriteHeight);
+
+// Sets the position of all the sprites at once, from structure of arrays coordinates.
+// The areas left and reached by the sprites that moved are merged into at most
+// SPRITE_FIELD_MAX_AREAS invalidated areas.
+void spriteFieldSync(SpriteField *field, const float *x, const float *y, int count);
+
+void spriteFieldClear(SpriteField *field);
+
+#endif // SPRITE_FIELD_H
@@ -0,0 +1,133 @@
+#include "taskProfiler.h"
+
+#if TASK_PROFILING
+
+#include <Arduino.h>
+#include "STM32FreeRTOS.h"
+#include "lvgl.h"
+
+#define PROFILER_LINE_SIZE 40
+
+struct TaskSample
+{
+    UBaseType_t number;
+    uint32_t runTime;
+};
+
+static TaskStatus_t tasks[TASK_PROFILER_MAX_TASKS];
+static TaskSample previous[TASK_PROFILER_MAX_TASKS];
+static UBaseType_t previousCount = 0;
+static uint32_t previousTotal = 0;
+
+static lv_obj_t *overlay;
+static char text[TASK_PROFILER_MAX_TASKS * PROFILER_LINE_SIZE];
+
+extern "C" void taskProfilerStartCounter(void)
+{
+    // Called by vTaskStartScheduler(). The Cortex-M7 DWT registers are locked after reset.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // The core clock stops in WFI: keep it running during the tickless idle, or the idle task
+    // would not be counted while it sleeps
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+}
+
+static uint32_t previousRunTime(UBaseType_t number)
+{
+    for (UBaseType_t i = 0; i < previousCount; i++)
+    {
+        if (previous[i].number == number)
+        {
+            return previous[i].runTime;
+        }
+    }
+
+    // Created since the previous sample, its counter started from 0
+    return 0;
+}
+
+static void sortByNumber(UBaseType_t count)
+{
+    // Creation order, so that the lines stay in place from one sample to the next
+    for (UBaseType_t i = 1; i < count; i++)
+    {
+        TaskStatus_t task = tasks[i];
+        UBaseType_t j = i;
+        while (j > 0 && tasks[j - 1].xTaskNumber > task.xTaskNumber)
+        {
+            tasks[j] = tasks[j - 1];
+            j--;
+        }
+        tasks[j] = task;
+    }
+}
+
+static void sample(void)
+{
+    uint32_t total;
+    UBaseType_t count = uxTaskGetSystemState(tasks, TASK_PROFILER_MAX_TASKS, &total);
+    if (count == 0)
+    {
+        Serial.println("profiler: more than TASK_PROFILER_MAX_TASKS tasks");
+        return;
+    }
+    sortByNumber(count);
+
+    // The counters wrap, only the differences over the period are used
+    uint32_t elapsed = total - previousTotal;
+    int length = 0;
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        uint32_t runTime = tasks[i].ulRunTimeCounter - previousRunTime(tasks[i].xTaskNumber);
+        uint32_t permille = elapsed ? (uint32_t)((uint64_t)runTime * 1000 / elapsed) : 0;
+        uint32_t stackLeft = tasks[i].usStackHighWaterMark * sizeof(StackType_t);
+
+        if (length < (int)sizeof(text))
+        {
+            length += snprintf(&text[length], sizeof(text) - length, "%s%-10s %3lu.%lu%%  %5lu B", i ? "\n" : "",
+                               tasks[i].pcTaskName, permille / 10, permille % 10, stackLeft);
+        }
+
+        previous[i].number = tasks[i].xTaskNumber;
+        previous[i].runTime = tasks[i].ulRunTimeCounter;
+    }
+    previousCount = count;
+    previousTotal = total;
+
+    Serial.println("task        cpu     stack left");
+    Serial.println(text);
+
+    lv_lock();
+    lv_label_set_text(overlay, text);
+    lv_unlock();
+}
+
+static void profilerTask(void *pvParameters)
+{
+    TickType_t lastWake = xTaskGetTickCount();
+
+    while (1)
+    {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(TASK_PROFILER_PERIOD_MS));
+        sample();
+    }
+}
+
+void taskProfilerBegin(void)
+{
+    // Same look as the LVGL monitors
+    overlay = lv_label_create(lv_layer_sys());
+    lv_obj_set_style_bg_opa(overlay, LV_OPA_50, 0);
+    lv_obj_set_style_bg_color(overlay, lv_color_black(), 0);
+    lv_obj_set_style_text_color(overlay, lv_color_white(), 0);
+    lv_obj_set_style_pad_all(overlay, 3, 0);
+    lv_obj_align(overlay, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_label_set_text(overlay, "?");
+
+    xTaskCreate(profilerTask, "profiler", 1024, NULL, osPriorityNormal, NULL);
+}
+
+#endif // TASK_PROFILING
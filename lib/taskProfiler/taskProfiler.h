@@ -0,0 +1,29 @@
+#ifndef TASK_PROFILER_H
+#define TASK_PROFILER_H
+
+// Profiling mode (env:disco_f746ng_profiling): FreeRTOS counts the run time of every task with the
+// DWT cycle counter (include/STM32FreeRTOSConfig_extra.h), and a task samples the CPU share and the
+// stack left of each one, to size the stacks and find which task eats the frame budget.
+#ifndef TASK_PROFILING
+#define TASK_PROFILING 0
+#endif
+
+// The DWT counter wraps every 19.9 s at 216 MHz, the samples must be closer
+#ifndef TASK_PROFILER_PERIOD_MS
+#define TASK_PROFILER_PERIOD_MS 1000
+#endif
+
+// uxTaskGetSystemState() returns nothing when there are more tasks
+#ifndef TASK_PROFILER_MAX_TASKS
+#define TASK_PROFILER_MAX_TASKS 16
+#endif
+
+#if TASK_PROFILING
+
+// Prints the samples on Serial and shows them in an overlay on the LVGL system layer, in the corner
+// left free by the performance and memory monitors. Call it after the display is created.
+void taskProfilerBegin(void);
+
+#endif
+
+#endif // TASK_PROFILER_H
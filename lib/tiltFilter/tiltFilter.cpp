@@ -0,0 +1,76 @@
+#include "tiltFilter.h"
+
+// Change of the gravity seen by an accelerometer axis for one gyro LSB during one sample period,
+// in Q12 accelerometer counts: 16384 counts/g * (pi / 180) rad/deg / 131 LSB/(deg/s) / rate.
+// Small angle approximation: the gravity component changes by g * angle.
+#define TILT_GYRO_GAIN_Q12 ((int32_t)(16384.0 * 3.14159265 / 180.0 / 131.0 / MPU6050_SAMPLE_RATE_HZ * 4096.0 + 0.5))
+
+void tiltFilterInit(TiltFilter *filter)
+{
+    filter->tiltX = 0;
+    filter->tiltY = 0;
+    filter->gyroBiasX = 0;
+    filter->gyroBiasY = 0;
+    filter->biasSumX = 0;
+    filter->biasSumY = 0;
+    filter->calibrationCount = 0;
+}
+
+bool tiltFilterCalibrated(const TiltFilter *filter)
+{
+    return filter->calibrationCount >= TILT_CALIBRATION_SAMPLES;
+}
+
+static int32_t blend(int32_t tilt, int32_t acc)
+{
+    return tilt + (int32_t)(((int64_t)(acc * 4096 - tilt) * TILT_ACC_WEIGHT_Q15) >> 15);
+}
+
+void tiltFilterUpdate(TiltFilter *filter, const Mpu6050Sample *sample)
+{
+    int32_t accX = sample->accX - TILT_ACC_OFFSET_X;
+    int32_t accY = sample->accY - TILT_ACC_OFFSET_Y;
+
+    if (!tiltFilterCalibrated(filter))
+    {
+        filter->biasSumX += sample->gyroX;
+        filter->biasSumY += sample->gyroY;
+        filter->calibrationCount++;
+        if (tiltFilterCalibrated(filter))
+        {
+            filter->gyroBiasX = (filter->biasSumX * 16) / TILT_CALIBRATION_SAMPLES;
+            filter->gyroBiasY = (filter->biasSumY * 16) / TILT_CALIBRATION_SAMPLES;
+        }
+
+        filter->tiltX = accX * 4096;
+        filter->tiltY = accY * 4096;
+        return;
+    }
+
+    // Rotating around Y tilts X down, rotating around X tilts Y up
+    int32_t gyroX = (sample->gyroX * 16) - filter->gyroBiasX;
+    int32_t gyroY = (sample->gyroY * 16) - filter->gyroBiasY;
+    filter->tiltX -= (gyroY * TILT_GYRO_GAIN_Q12) >> 4;
+    filter->tiltY += (gyroX * TILT_GYRO_GAIN_Q12) >> 4;
+
+    filter->tiltX = blend(filter->tiltX, accX);
+    filter->tiltY = blend(filter->tiltY, accY);
+}
+
+// The gyro can push the tilt beyond the accelerometer range, up to the steady offset of a full scale
+// rotation: the output saturates instead of wrapping around
+static int16_t saturate(int32_t tilt)
+{
+    int32_t counts = tilt >> 12;
+    return (int16_t)(counts > INT16_MAX ? INT16_MAX : (counts < INT16_MIN ? INT16_MIN : counts));
+}
+
+int16_t tiltFilterX(const TiltFilter *filter)
+{
+    return saturate(filter->tiltX);
+}
+
+int16_t tiltFilterY(const TiltFilter *filter)
+{
+    return saturate(filter->tiltY);
+}
@@ -0,0 +1,49 @@
+#ifndef TILT_FILTER_H
+#define TILT_FILTER_H
+
+#include "mpu6050.h"
+
+// Samples averaged at startup to measure the gyro bias, the board must stay still meanwhile
+#define TILT_CALIBRATION_SAMPLES (MPU6050_SAMPLE_RATE_HZ / 2)
+
+// Accelerometer readings of the board lying flat, measured once for a given sensor
+#ifndef TILT_ACC_OFFSET_X
+#define TILT_ACC_OFFSET_X 0
+#endif
+#ifndef TILT_ACC_OFFSET_Y
+#define TILT_ACC_OFFSET_Y 0
+#endif
+
+// Weight of the accelerometer in each update, in 1/32768. 655 (2%) gives a time constant of
+// about 0.25 s at 200 Hz: the gyro makes the tilt react at once, the accelerometer slowly
+// removes its drift and the hand jitter never reaches the output directly.
+#ifndef TILT_ACC_WEIGHT_Q15
+#define TILT_ACC_WEIGHT_Q15 655
+#endif
+
+// Complementary filter of the gravity seen by the X and Y axes of the accelerometer, integer only.
+// The tilt is in accelerometer counts (16384 = 1 g), like the raw readings it replaces.
+struct TiltFilter
+{
+    int32_t tiltX;  // Q12
+    int32_t tiltY;  // Q12
+    int32_t gyroBiasX;  // Q4
+    int32_t gyroBiasY;  // Q4
+
+    int32_t biasSumX;
+    int32_t biasSumY;
+    int calibrationCount;
+};
+
+void tiltFilterInit(TiltFilter *filter);
+
+// Feeds one sample, at the sample rate of the sensor. During the calibration the output follows the
+// accelerometer.
+void tiltFilterUpdate(TiltFilter *filter, const Mpu6050Sample *sample);
+
+bool tiltFilterCalibrated(const TiltFilter *filter);
+
+int16_t tiltFilterX(const TiltFilter *filter);
+int16_t tiltFilterY(const TiltFilter *filter);
+
+#endif // TILT_FILTER_H
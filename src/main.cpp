@@ -2,46 +2,48 @@
  * BIBLIOTHÈQUES
  ******************************************************************************/
 #include <Arduino.h>      // Inclut la bibliothèque principale d'Arduino pour les fonctions de base.
-#include <Wire.h>         // Inclut la bibliothèque pour la communication sur le bus I2C (utilisé par le capteur).
 #include <math.h>         // Inclut la bibliothèque mathématique C++ pour les fonctions complexes.
 #include "lvgl.h"        // Inclut la bibliothèque graphique LVGL pour créer l'interface utilisateur.
 #include "lvglDrivers.h" // Inclut les pilotes pour faire le lien entre LVGL, l'écran et le tactile.
+#include "gamePhysics.h" // Inclut le moteur physique des obstacles, indépendant de LVGL.
+#include "spriteField.h" // Inclut le widget qui dessine tous les obstacles d'un coup.
+#include "mpu6050.h"     // Inclut le pilote du capteur MPU6050, lu en I2C par sa propre tâche.
+#include "tiltFilter.h"  // Inclut le filtre qui combine le gyroscope et l'accéléromètre.
+#include "tripleBuffer.h" // Inclut la boîte aux lettres sans verrou qui passe l'état du jeu à l'interface.
+#include "blendBenchmark.h" // Inclut la mesure des boucles de mélange de pixels de LVGL (env:disco_f746ng_blend_bench).
 
 /******************************************************************************
  * CONSTANTES ET DÉFINITIONS
  ******************************************************************************/
-#define MPU6050_ADDR 0x68       // Définit l'adresse I2C du capteur MPU6050 comme étant 0x68.
 #define SCREEN_WIDTH 480        // Définit la largeur de l'écran à 480 pixels.
 #define SCREEN_HEIGHT 270       // Définit la hauteur de l'écran à 270 pixels.
 #define BALL_SIZE 20            // Définit la taille (diamètre) de la balle à 20 pixels.
 #define CENTER_X (SCREEN_WIDTH / 2 - BALL_SIZE / 2)   // Calcule et définit la coordonnée X de départ pour centrer la balle.
 #define CENTER_Y (SCREEN_HEIGHT / 2 - BALL_SIZE / 2)  // Calcule et définit la coordonnée Y de départ pour centrer la balle.
 #define MAX_COLLISIONS 3        // Définit le nombre maximum de collisions autorisées (vies du joueur).
-#define MAX_OBSTACLES 50        // Définit le nombre maximum d'obstacles qui peuvent exister en même temps.
 #define OBSTACLE_SIZE 20        // Définit la taille des obstacles carrés à 20x20 pixels.
 #define OBSTACLE_SPEED 1.5f     // Définit la vitesse de déplacement des obstacles (le 'f' indique un nombre à virgule).
-
-/******************************************************************************
- * STRUCTURES DE DONNÉES
- ******************************************************************************/
-typedef struct { // Déclare le début d'une nouvelle structure de données personnalisée.
-    lv_obj_t* obj;          // Un pointeur ('*') pour stocker l'objet graphique LVGL de cet obstacle.
-    float x_pos;            // La position horizontale (X) exacte (avec décimales).
-    float y_pos;            // La position verticale (Y) exacte (avec décimales).
-    float dx;               // La vitesse de déplacement sur l'axe X.
-    float dy;               // La vitesse de déplacement sur l'axe Y.
-} Obstacle;                 // Ferme la définition de la structure et lui donne le nom de type 'Obstacle'.
+#define OBSTACLES_COLLIDE false // Mettre à 'true' pour que les obstacles rebondissent aussi les uns sur les autres.
+#define BALL_CONTROL_FUSED 1    // 1 : la balle suit l'inclinaison filtrée (gyroscope + accéléromètre), 0 : la moyenne brute de l'accéléromètre.
+#define GAME_STEP_MS 20         // Période de la tâche du jeu : 50 pas par seconde, quel que soit le temps de rendu.
+#define OBSTACLE_SPAWN_MS 2000  // Un obstacle apparaît toutes les 2 secondes.
+#define SCORE_PERIOD_MS 1000    // Le score augmente toutes les secondes.
+#define GREEN_CUBE_DELAY_MS 5000 // Délai avant la réapparition du cube vert.
+#define MENU_SENSOR_MS 200      // Hors partie, la tâche du jeu ne se réveille que pour vider la file du capteur (64 échantillons, 320 ms).
 
 /******************************************************************************
  * VARIABLES GLOBALES
  ******************************************************************************/
-// --- Objets graphiques LVGL ---
-lv_obj_t *ball;               // Déclare un pointeur pour l'objet graphique de la balle.
+// Deux tâches se partagent le jeu : la tâche du jeu (myTask, prioritaire, 50 Hz) fait la simulation sans jamais
+// toucher à LVGL, et la tâche LVGL fait l'affichage. Les variables ci-dessous appartiennent à l'une ou à l'autre.
+
+// --- Objets graphiques LVGL (tâche LVGL uniquement) ---
+lv_obj_t *ball;               // Déclare un pointeur pour l'objet graphique de la balle (dessiné une fois dans le sprite matériel).
 lv_obj_t *gameOverLabel;      // Déclare un pointeur pour le texte "GAME OVER".
 lv_obj_t *lifeLabel;          // Déclare un pointeur pour le texte affichant les vies.
 lv_obj_t *scoreLabel;         // Déclare un pointeur pour le texte affichant le score.
 lv_obj_t *scoreGameOverLabel; // Déclare un pointeur pour le texte du score final.
-Obstacle obstacles[MAX_OBSTACLES]; // Crée un tableau (liste) pour stocker tous les objets de type 'Obstacle'.
+SpriteField obstacleField;         // Un seul objet LVGL qui dessine tous les cubes bleus aux positions du monde physique.
 lv_obj_t *greenCube = NULL;   // Déclare un pointeur pour le cube vert, initialisé à NULL (il n'existe pas encore).
 
 // --- Conteneurs d'écrans ---
@@ -49,30 +51,59 @@ lv_obj_t *main_menu_container;  // Déclare un pointeur pour le conteneur du men
 lv_obj_t *color_menu_container; // Déclare un pointeur pour le conteneur du menu de sélection de couleur.
 lv_color_t ball_color;          // Déclare une variable pour stocker la couleur choisie pour la balle.
 
-// --- États et données du jeu ---
+// --- État affiché par l'interface (tâche LVGL uniquement) ---
+int uiGame = 0;                 // Numéro de la partie lancée par le menu.
+bool uiPlaying = false;         // Vrai tant que l'interface affiche une partie en cours.
+int shownLives = -1;            // Nombre de vies affiché, pour ne changer le texte que s'il change.
+int shownScore = -1;            // Score affiché.
+
+// --- État du jeu (tâche du jeu uniquement) ---
+int gameNumber = 0;             // Numéro de la partie simulée, recopié de l'ordre de démarrage.
 bool gameStarted = false;       // Déclare un booléen (vrai/faux) pour savoir si le jeu a commencé, initialisé à 'faux'.
 bool isGameOver = false;        // Déclare un booléen pour savoir si la partie est terminée, initialisé à 'faux'.
 int collisionCount = 0;         // Déclare un entier pour compter les collisions (vies perdues), initialisé à 0.
 int score = 0;                  // Déclare un entier pour le score du joueur, initialisé à 0.
 int ballX = CENTER_X;           // Déclare la position X de la balle et l'initialise au centre.
 int ballY = CENTER_Y;           // Déclare la position Y de la balle et l'initialise au centre.
-int16_t accX = 0, accY = 0;     // Déclare deux entiers 16-bit pour stocker les données brutes de l'accéléromètre.
-
-// --- Timers LVGL (tâches répétitives) ---
-lv_timer_t* obstacle_spawn_timer = NULL;   // Déclare un pointeur de timer pour la création d'obstacles.
-lv_timer_t* score_timer = NULL;            // Déclare un pointeur de timer pour l'incrémentation du score.
-lv_timer_t* movement_timer = NULL;         // Déclare un pointeur de timer pour la boucle de jeu principale.
-lv_timer_t* green_cube_spawn_timer = NULL; // Déclare un pointeur de timer pour l'apparition du cube vert.
+int16_t accX = 0, accY = 0;     // Déclare deux entiers 16-bit pour stocker l'inclinaison mesurée (en unités de l'accéléromètre).
+TiltFilter tiltFilter;          // État du filtre d'inclinaison, nourri par tous les échantillons du capteur.
+PhysicsWorld obstacleWorld;     // Positions et vitesses des obstacles (tableaux séparés), simulées sans toucher à LVGL.
+bool greenCubeVisible = false;  // Vrai quand le cube vert peut être ramassé.
+int greenCubeX = 0;             // Position X du cube vert.
+int greenCubeY = 0;             // Position Y du cube vert.
+uint32_t lastPhysicsTick = 0;   // Instant du dernier pas du jeu, pour avancer la physique à pas fixe.
+uint32_t nextObstacleTick = 0;  // Instant de la prochaine apparition d'obstacle (remplace le timer LVGL).
+uint32_t nextScoreTick = 0;     // Instant du prochain gain de points.
+uint32_t nextGreenCubeTick = 0; // Instant de la prochaine apparition du cube vert (0 : aucune prévue).
+
+// --- Échanges entre la tâche du jeu et l'interface ---
+struct GameView {               // Tout ce que l'interface doit afficher, recopié par la tâche du jeu à chaque pas.
+    int game;                   // Numéro de la partie, pour ignorer l'état d'une partie précédente.
+    bool playing;               // Partie en cours.
+    bool over;                  // Partie terminée (plus de vies).
+    int ballX, ballY;           // Position de la balle.
+    int lives;                  // Vies restantes.
+    int score;                  // Score.
+    bool greenCubeVisible;      // Cube vert affiché ou non.
+    int greenCubeX, greenCubeY; // Position du cube vert.
+    int obstacleCount;          // Nombre d'obstacles.
+    float obstacleX[PHYSICS_MAX_BODIES]; // Positions X des obstacles.
+    float obstacleY[PHYSICS_MAX_BODIES]; // Positions Y des obstacles.
+}; // Fin de la structure GameView.
+TripleBuffer<GameView> gameView; // Publié par la tâche du jeu, lu par le timer de l'interface : aucun des deux n'attend l'autre.
+QueueHandle_t gameCommands;     // File des ordres de l'interface vers le jeu (le numéro de la partie à démarrer).
+
+// --- Timers LVGL (interface uniquement) ---
+lv_timer_t* ui_timer = NULL;    // Timer qui recopie le dernier état du jeu dans les objets LVGL.
 
 /******************************************************************************
  * DÉCLARATIONS ANTICIPÉES DES FONCTIONS
  ******************************************************************************/
 // Permet d'utiliser ces fonctions avant leur définition complète plus bas dans le code.
-void gameLoop(lv_timer_t *timer);   // Déclaration anticipée de la fonction de la boucle de jeu.
+void syncUi(lv_timer_t *timer);     // Déclaration anticipée de la fonction qui met l'affichage à jour.
 void createMainMenu();              // Déclaration anticipée de la fonction de création du menu principal.
 void createColorMenu();             // Déclaration anticipée de la fonction de création du menu des couleurs.
 void initGreenCubeObject();         // Déclaration anticipée de la fonction d'initialisation du cube vert.
-void spawnGreenCube(lv_timer_t *timer); // Déclaration anticipée de la fonction d'apparition du cube vert.
 void returnToMenu(lv_timer_t *timer);   // Déclaration anticipée de la fonction de retour au menu.
 
 /******************************************************************************
@@ -102,90 +133,60 @@ lv_obj_t* createBasicLvObject(lv_obj_t* parent, lv_coord_t width, lv_coord_t hei
 /******************************************************************************
  * GESTION DES OBSTACLES BLEUS
  ******************************************************************************/
-// Définit la fonction 'initObstacles' qui ne prend pas d'argument et ne retourne rien.
+// Définit la fonction 'initObstacles', qui crée le widget des obstacles (interface).
 void initObstacles() {
-    for (int i = 0; i < MAX_OBSTACLES; i++) {   // Démarre une boucle 'for' qui compte de 0 jusqu'à MAX_OBSTACLES-1.
-        obstacles[i].obj = NULL;                // Pour chaque case du tableau, met le pointeur de l'objet à NULL (indiquant un emplacement vide).
-    } // Fin de la boucle for.
+    lv_obj_t *field = spriteFieldCreate(&obstacleField, lv_screen_active(), OBSTACLE_SIZE, OBSTACLE_SIZE); // Crée le widget des obstacles, qui couvre tout l'écran.
+    lv_obj_set_style_bg_color(field, lv_color_hex(0x0000FF), LV_PART_ITEMS); // Les cubes sont bleus...
+    lv_obj_set_style_bg_opa(field, LV_OPA_COVER, LV_PART_ITEMS); // ...et opaques (de simples remplissages, faits par le DMA2D).
 } // Fin de la fonction initObstacles.
 
-// Définit la fonction 'clearObstacles'.
-void clearObstacles() {
-    for (int i = 0; i < MAX_OBSTACLES; i++) {   // Démarre une boucle pour parcourir tous les emplacements d'obstacles possibles.
-        if (obstacles[i].obj != NULL) {         // Si un objet existe à cet emplacement (le pointeur n'est pas nul)...
-            lv_obj_del(obstacles[i].obj);       // ...alors supprime l'objet graphique correspondant de l'écran.
-            obstacles[i].obj = NULL;            // ...et remet le pointeur à NULL pour marquer l'emplacement comme libre.
-        } // Fin du bloc de condition 'if'.
-    } // Fin de la boucle for.
-} // Fin de la fonction clearObstacles.
-
-// Définit la fonction 'createObstacle' qui est appelée par un timer.
-void createObstacle(lv_timer_t *timer) {
-    if (!gameStarted || isGameOver) return; // Si le jeu n'a pas commencé OU s'il est terminé, quitte immédiatement la fonction.
-
-    for (int i = 0; i < MAX_OBSTACLES; i++) { // Boucle pour trouver un emplacement d'obstacle libre.
-        if (obstacles[i].obj == NULL) {     // Si l'emplacement 'i' est libre...
-            obstacles[i].obj = createBasicLvObject(lv_screen_active(), OBSTACLE_SIZE, OBSTACLE_SIZE, lv_color_hex(0x0000FF), false); // ...crée un cube bleu sur l'écran actif.
-            
-            int side = random(0, 4);        // Choisit un nombre aléatoire entre 0 et 3 pour le côté d'apparition.
-            float x, y;                     // Déclare les variables pour les coordonnées de départ.
-            switch (side) {                 // Commence une structure de choix basée sur la variable 'side'.
-                case 0: x = random(0, SCREEN_WIDTH - OBSTACLE_SIZE); y = -OBSTACLE_SIZE; obstacles[i].dx = 0; obstacles[i].dy = OBSTACLE_SPEED; break; // Cas 0: Apparition en haut.
-                case 1: x = random(0, SCREEN_WIDTH - OBSTACLE_SIZE); y = SCREEN_HEIGHT; obstacles[i].dx = 0; obstacles[i].dy = -OBSTACLE_SPEED; break; // Cas 1: Apparition en bas.
-                case 2: x = -OBSTACLE_SIZE; y = random(0, SCREEN_HEIGHT - OBSTACLE_SIZE); obstacles[i].dx = OBSTACLE_SPEED; obstacles[i].dy = 0; break; // Cas 2: Apparition à gauche.
-                case 3: x = SCREEN_WIDTH; y = random(0, SCREEN_HEIGHT - OBSTACLE_SIZE); obstacles[i].dx = -OBSTACLE_SPEED; obstacles[i].dy = 0; break; // Cas 3: Apparition à droite.
-            } // Fin du 'switch'.
-            lv_obj_set_pos(obstacles[i].obj, (lv_coord_t)x, (lv_coord_t)y); // Positionne l'objet graphique aux coordonnées calculées.
-            obstacles[i].x_pos = x;         // Stocke la position X exacte dans la structure de l'obstacle.
-            obstacles[i].y_pos = y;         // Stocke la position Y exacte dans la structure de l'obstacle.
-            return;                         // Quitte la fonction car un obstacle a été créé (inutile de continuer la boucle).
-        } // Fin du bloc 'if'.
-    } // Fin de la boucle 'for'.
+// Définit la fonction 'createObstacle', appelée par la tâche du jeu toutes les OBSTACLE_SPAWN_MS.
+void createObstacle() {
+    int side = random(0, 4);        // Choisit un nombre aléatoire entre 0 et 3 pour le côté d'apparition.
+    float x, y, dx, dy;             // Déclare les variables pour les coordonnées et la vitesse de départ.
+    switch (side) {                 // Commence une structure de choix basée sur la variable 'side'.
+        case 0: x = random(0, SCREEN_WIDTH - OBSTACLE_SIZE); y = -OBSTACLE_SIZE; dx = 0; dy = OBSTACLE_SPEED; break; // Cas 0: Apparition en haut.
+        case 1: x = random(0, SCREEN_WIDTH - OBSTACLE_SIZE); y = SCREEN_HEIGHT; dx = 0; dy = -OBSTACLE_SPEED; break; // Cas 1: Apparition en bas.
+        case 2: x = -OBSTACLE_SIZE; y = random(0, SCREEN_HEIGHT - OBSTACLE_SIZE); dx = OBSTACLE_SPEED; dy = 0; break; // Cas 2: Apparition à gauche.
+        default: x = SCREEN_WIDTH; y = random(0, SCREEN_HEIGHT - OBSTACLE_SIZE); dx = -OBSTACLE_SPEED; dy = 0; break; // Cas 3: Apparition à droite.
+    } // Fin du 'switch'.
+
+    physicsAdd(&obstacleWorld, x, y, dx, dy); // Ajoute le corps de l'obstacle dans le monde physique (ignoré si le monde est plein), il sera dessiné à la prochaine image.
 } // Fin de la fonction createObstacle.
 
 /******************************************************************************
- * GESTION DE L'INTERFACE UTILISATEUR (UI) ET DE L'ÉTAT DU JEU
+ * GESTION DE L'INTERFACE UTILISATEUR (UI)
  ******************************************************************************/
 // Définit la fonction 'updateLifeLabel (pour le nombre de vie).
-void updateLifeLabel() {
-    if (lifeLabel) { // Vérifie si le pointeur 'lifeLabel' est valide (n'est pas NULL).
+void updateLifeLabel(int lives) {
+    if (lifeLabel && lives != shownLives) { // Si le label existe et que le nombre de vies a changé...
         char buf[16]; // Crée un tableau de 16 caractères pour stocker le texte.
-        snprintf(buf, sizeof(buf), "Vies : %d", MAX_COLLISIONS - collisionCount); // Formate le texte "Vies : X" et le met dans 'buf'.
+        snprintf(buf, sizeof(buf), "Vies : %d", lives); // Formate le texte "Vies : X" et le met dans 'buf'.
         lv_label_set_text(lifeLabel, buf); // Met à jour le texte de l'objet 'lifeLabel' avec le contenu de 'buf'.
+        shownLives = lives; // Mémorise la valeur affichée.
     } // Fin du bloc 'if'.
 } // Fin de la fonction updateLifeLabel.
 
-// Définit la fonction 'incrementScore', appelée par un timer (ajoute du score par seconde).
-void incrementScore(lv_timer_t *timer) {
-    if (gameStarted && !isGameOver) { // Si le jeu est en cours ET que ce n'est pas game over...
-        score += 10; // ...ajoute 10 points au score.
-        if (scoreLabel) { // Vérifie si l'objet 'scoreLabel' existe.
-            char buf[32]; // Crée un buffer de 32 caractères pour le texte du score.
-            snprintf(buf, sizeof(buf), "Score : %d", score); // Formate le texte "Score : X" et le met dans 'buf'.
-            lv_label_set_text(scoreLabel, buf); // Met à jour l'objet texte du score.
-        } // Fin du bloc 'if'.
+// Définit la fonction 'updateScoreLabel'.
+void updateScoreLabel(int value) {
+    if (scoreLabel && value != shownScore) { // Si le label existe et que le score a changé...
+        char buf[32]; // Crée un buffer de 32 caractères pour le texte du score.
+        snprintf(buf, sizeof(buf), "Score : %d", value); // Formate le texte "Score : X" et le met dans 'buf'.
+        lv_label_set_text(scoreLabel, buf); // Met à jour l'objet texte du score.
+        shownScore = value; // Mémorise la valeur affichée.
     } // Fin du bloc 'if'.
-} // Fin de la fonction incrementScore.
+} // Fin de la fonction updateScoreLabel.
 
-// Définit la fonction 'gameOver'.
-void gameOver() {
-    gameStarted = false; // Met la variable d'état du jeu à 'faux'.
-    isGameOver = true;   // Met la variable d'état de fin de partie à 'vrai'.
-    if (ball) { // Si l'objet balle existe...
-        lv_obj_add_flag(ball, LV_OBJ_FLAG_HIDDEN); // ...lui ajoute le drapeau "caché" pour le faire disparaître.
-    } // Fin du bloc 'if'.
-
-    // Arrête et supprime tous les timers du jeu pour économiser les ressources.
-    if (obstacle_spawn_timer) { lv_timer_del(obstacle_spawn_timer); obstacle_spawn_timer = NULL; } // Supprime le timer des obstacles.
-    if (score_timer) { lv_timer_del(score_timer); score_timer = NULL; } // Supprime le timer du score.
-    if (movement_timer) { lv_timer_del(movement_timer); movement_timer = NULL; } // Supprime le timer de la boucle de jeu.
-    if (green_cube_spawn_timer) { lv_timer_del(green_cube_spawn_timer); green_cube_spawn_timer = NULL; } // Supprime le timer du cube vert.
+// Définit la fonction 'gameOver', appelée par l'interface quand le jeu annonce la fin de la partie.
+void gameOver(const GameView *view) {
+    uiPlaying = false; // L'interface n'affiche plus de partie en cours.
+    hwSpriteSetVisible(false); // Cache le sprite matériel de la balle pour la faire disparaître.
 
     // Supprime les labels de l'interface de jeu.
     if (lifeLabel) { lv_obj_del(lifeLabel); lifeLabel = NULL; } // Supprime le label des vies.
     if (scoreLabel) { lv_obj_del(scoreLabel); scoreLabel = NULL; } // Supprime le label du score.
 
-    clearObstacles(); // Appelle la fonction pour supprimer tous les obstacles bleus de l'écran.
+    spriteFieldClear(&obstacleField); // Efface les cubes de l'écran (seules leurs zones sont redessinées).
 
     if (greenCube) { lv_obj_add_flag(greenCube, LV_OBJ_FLAG_HIDDEN); } // Cache le cube vert s'il est visible.
 
@@ -198,13 +199,15 @@ void gameOver() {
     // Affiche le score final.
     scoreGameOverLabel = lv_label_create(lv_screen_active()); // Crée un autre objet label.
     char buf[32]; // Crée un buffer de 32 caractères.
-    snprintf(buf, sizeof(buf), "Score final : %d", score); // Formate le texte du score final.
+    snprintf(buf, sizeof(buf), "Score final : %d", view->score); // Formate le texte du score final.
     lv_label_set_text(scoreGameOverLabel, buf); // Applique ce texte au label.
     lv_obj_align_to(scoreGameOverLabel, gameOverLabel, LV_ALIGN_OUT_BOTTOM_MID, 0, 10); // Aligne ce label sous le message "GAME OVER".
 
     // Crée un timer à usage unique pour revenir au menu après 3 secondes.
     lv_timer_t *t = lv_timer_create(returnToMenu, 3000, NULL); // Crée un timer qui appellera 'returnToMenu' dans 3000 ms.
     lv_timer_set_repeat_count(t, 1); // Configure ce timer pour qu'il ne s'exécute qu'une seule fois.
+
+    lv_timer_pause(ui_timer); // Plus rien à recopier : la tâche LVGL (et le processeur) peut dormir jusqu'au prochain événement.
 } // Fin de la fonction gameOver.
 
 // Définit la fonction 'returnToMenu', appelée par un timer.
@@ -212,26 +215,12 @@ void returnToMenu(lv_timer_t *timer) {
     if (gameOverLabel) { lv_obj_del(gameOverLabel); gameOverLabel = NULL; } // Si le label "GAME OVER" existe, le supprime.
     if (scoreGameOverLabel) { lv_obj_del(scoreGameOverLabel); scoreGameOverLabel = NULL; } // Si le label du score final existe, le supprime.
 
-    clearObstacles(); // Appelle la fonction pour effacer tous les obstacles.
+    spriteFieldClear(&obstacleField); // Efface tous les obstacles de l'écran.
 
-    ballX = CENTER_X; // Réinitialise la coordonnée X de la balle.
-    ballY = CENTER_Y; // Réinitialise la coordonnée Y de la balle.
-    if (ball) { // Si l'objet balle existe...
-        lv_obj_set_pos(ball, ballX, ballY); // ...le repositionne au centre.
-        lv_obj_add_flag(ball, LV_OBJ_FLAG_HIDDEN); // ...et le cache.
-    } // Fin du bloc 'if'.
+    hwSpriteSetPos(CENTER_X, CENTER_Y); // Repositionne le sprite de la balle au centre.
+    hwSpriteSetVisible(false); // Et le cache.
 
     if (greenCube) { lv_obj_add_flag(greenCube, LV_OBJ_FLAG_HIDDEN); } // Cache le cube vert.
-    if (green_cube_spawn_timer) { // Si le timer du cube vert existe...
-        lv_timer_del(green_cube_spawn_timer); // ...le supprime.
-        green_cube_spawn_timer = NULL; // ...et met son pointeur à NULL.
-    } // Fin du bloc 'if'.
-
-    // Réinitialise toutes les variables d'état du jeu à leurs valeurs par défaut.
-    collisionCount = 0; // Remet le compteur de collisions à zéro.
-    score = 0; // Remet le score à zéro.
-    isGameOver = false; // Indique que la partie n'est plus terminée.
-    gameStarted = false; // Indique que le jeu n'est plus en cours.
 
     if (main_menu_container) { // Si le conteneur du menu principal existe...
         lv_obj_clear_flag(main_menu_container, LV_OBJ_FLAG_HIDDEN); // ...enlève son drapeau "caché" pour le rendre visible.
@@ -239,49 +228,61 @@ void returnToMenu(lv_timer_t *timer) {
 } // Fin de la fonction returnToMenu.
 
 
-// Définit la fonction 'startGame'.
+// Définit la fonction 'startGame', appelée par le bouton "JOUER".
 void startGame() {
     if (main_menu_container) lv_obj_add_flag(main_menu_container, LV_OBJ_FLAG_HIDDEN); // Cache le menu principal.
     if (color_menu_container) lv_obj_add_flag(color_menu_container, LV_OBJ_FLAG_HIDDEN); // Cache le menu des couleurs.
 
-    // Met à jour les variables d'état pour une nouvelle partie.
-    gameStarted = true; // Indique que le jeu a commencé.
-    isGameOver = false; // Indique que ce n'est pas encore la fin de la partie.
-    ballX = CENTER_X; // Réinitialise la position X de la balle.
-    ballY = CENTER_Y; // Réinitialise la position Y de la balle.
-    collisionCount = 0; // Réinitialise le compteur de collisions.
-    score = 0; // Réinitialise le score.
+    uiGame++; // Nouvelle partie : l'état publié pour la précédente sera ignoré.
+    uiPlaying = true; // L'interface affiche maintenant la partie.
 
     if (ball) { // Si l'objet balle existe...
         lv_obj_set_style_bg_color(ball, ball_color, 0); // ...applique la couleur choisie par le joueur.
-        lv_obj_clear_flag(ball, LV_OBJ_FLAG_HIDDEN); // ...le rend visible en enlevant le drapeau "caché".
-        lv_obj_set_pos(ball, ballX, ballY); // ...le place au centre de l'écran.
+        hwSpriteSetContent(ball); // ...redessine la balle dans le sprite matériel.
     } // Fin du bloc 'if'.
+    hwSpriteSetPos(CENTER_X, CENTER_Y); // Place le sprite de la balle au centre de l'écran.
+    hwSpriteSetVisible(true); // Rend le sprite visible.
 
-    clearObstacles(); // Efface les éventuels obstacles d'une partie précédente.
-    initObstacles();  // Réinitialise le tableau des obstacles.
+    spriteFieldClear(&obstacleField); // Efface les éventuels obstacles d'une partie précédente.
 
     lifeLabel = lv_label_create(lv_screen_active()); // Crée le label pour les vies.
     lv_obj_align(lifeLabel, LV_ALIGN_TOP_LEFT, 10, 5); // Le positionne en haut à gauche.
-    updateLifeLabel(); // Met à jour son texte initial.
+    shownLives = -1; // Force l'écriture du premier texte.
+    updateLifeLabel(MAX_COLLISIONS); // Met à jour son texte initial.
 
     scoreLabel = lv_label_create(lv_screen_active()); // Crée le label pour le score.
     lv_obj_align(scoreLabel, LV_ALIGN_TOP_LEFT, 10, 25); // Le positionne sous le label des vies.
-    lv_label_set_text(scoreLabel, "Score : 0"); // Met son texte initial à "Score : 0".
+    shownScore = -1; // Force l'écriture du premier texte.
+    updateScoreLabel(0); // Met son texte initial à "Score : 0".
+
+    xQueueSend(gameCommands, &uiGame, 0); // Demande à la tâche du jeu de démarrer la partie.
+    lv_timer_resume(ui_timer); // Recopie l'état du jeu à l'écran pendant toute la partie.
+} // Fin de la fonction startGame.
 
-    // Crée et démarre tous les timers nécessaires au déroulement du jeu.
-    obstacle_spawn_timer = lv_timer_create(createObstacle, 2000, NULL); // Un obstacle apparaîtra toutes les 2 secondes.
-    score_timer = lv_timer_create(incrementScore, 1000, NULL);          // Le score augmentera toutes les secondes.
-    movement_timer = lv_timer_create(gameLoop, 20, NULL);               // La boucle de jeu s'exécutera toutes les 20 ms (50 FPS).
+// Définit la fonction 'syncUi', appelée par un timer LVGL : recopie le dernier état publié par le jeu à l'écran.
+void syncUi(lv_timer_t *timer) {
+    const GameView *view = gameView.read(); // Prend le dernier état publié (sans attendre la tâche du jeu).
+    if (!uiPlaying || view == NULL || view->game != uiGame) return; // Rien à afficher hors partie, ou si le jeu n'a pas encore démarré celle-ci.
 
-    spawnGreenCube(NULL); // Fait apparaître le premier cube vert immédiatement.
-    if (green_cube_spawn_timer) { // S'assure qu'aucun ancien timer n'existe.
-        lv_timer_del(green_cube_spawn_timer); // Le supprime le cas échéant.
-        green_cube_spawn_timer = NULL; // Met le pointeur à NULL.
+    if (view->over) { // Si la partie vient de se terminer...
+        gameOver(view); // ...affiche l'écran de fin.
+        return; // Quitte la fonction.
     } // Fin du bloc 'if'.
-    green_cube_spawn_timer = lv_timer_create(spawnGreenCube, 5000, NULL); // Programme l'apparition du prochain cube dans 5 secondes.
-    lv_timer_set_repeat_count(green_cube_spawn_timer, 1); // Ce timer ne s'exécutera qu'une fois.
-} // Fin de la fonction startGame.
+
+    hwSpriteSetPos(view->ballX, view->ballY); // Déplace le sprite de la balle : seule la fenêtre de la couche LTDC change, LVGL ne redessine rien.
+    spriteFieldSync(&obstacleField, view->obstacleX, view->obstacleY, view->obstacleCount); // Synchronise les obstacles, en quelques zones à redessiner regroupées.
+    updateLifeLabel(view->lives); // Met à jour le texte des vies s'il a changé.
+    updateScoreLabel(view->score); // Met à jour le texte du score s'il a changé.
+
+    if (greenCube) { // Si le cube vert existe...
+        if (view->greenCubeVisible) { // ...et qu'il doit être affiché...
+            lv_obj_set_pos(greenCube, view->greenCubeX, view->greenCubeY); // ...le place (LVGL ne redessine rien si la position ne change pas).
+            lv_obj_clear_flag(greenCube, LV_OBJ_FLAG_HIDDEN); // ...et le montre.
+        } else { // Sinon...
+            lv_obj_add_flag(greenCube, LV_OBJ_FLAG_HIDDEN); // ...le cache.
+        } // Fin du bloc if/else.
+    } // Fin du bloc 'if'.
+} // Fin de la fonction syncUi.
 
 /******************************************************************************
  * CRÉATION DES MENUS
@@ -292,6 +293,7 @@ void color_select_event_cb(lv_event_t * e) {
     ball_color = lv_obj_get_style_bg_color(swatch, 0);       // Récupère la couleur de fond de cet objet.
     if (ball) { // Si la balle existe...
         lv_obj_set_style_bg_color(ball, ball_color, 0);       // ...applique cette nouvelle couleur à la balle.
+        hwSpriteSetContent(ball);                             // ...et redessine la balle dans le sprite matériel.
     } // Fin du bloc 'if'.
 } // Fin de la fonction color_select_event_cb.
 
@@ -301,6 +303,7 @@ void createMainMenu() {
     lv_obj_remove_style_all(main_menu_container); // Supprime tout style par défaut (bordure, fond) pour qu'il soit transparent.
     lv_obj_set_size(main_menu_container, SCREEN_WIDTH, SCREEN_HEIGHT); // Lui donne la taille de l'écran.
     lv_obj_center(main_menu_container); // Le centre sur l'écran.
+    lv_obj_add_flag(main_menu_container, LV_OBJ_FLAG_CACHE_AS_BITMAP); // Garde le menu dessiné dans une image en SDRAM : les rafraîchissements suivants la recopient.
 
     lv_obj_t* playBtn = lv_btn_create(main_menu_container); // Crée un bouton "JOUER" comme enfant du conteneur.
     lv_obj_align(playBtn, LV_ALIGN_CENTER, 0, -25); // L'aligne au centre, légèrement décalé vers le haut.
@@ -316,12 +319,9 @@ void createMainMenu() {
     lv_obj_center(colorLabel); // Centre le texte dans le bouton.
     lv_obj_add_event_cb(colorBtn, [](lv_event_t *e) { // Ajoute une action pour le clic sur le bouton "Couleur".
         if (main_menu_container) lv_obj_add_flag(main_menu_container, LV_OBJ_FLAG_HIDDEN); // Cache le menu principal.
-        if (ball) { // Si la balle existe...
-            ballX = CENTER_X; // ...réinitialise sa position X au centre.
-            ballY = CENTER_Y; // ...réinitialise sa position Y au centre.
-            lv_obj_set_pos(ball, ballX, ballY); // ...applique cette position.
-            lv_obj_clear_flag(ball, LV_OBJ_FLAG_HIDDEN); // ...et la rend visible pour la prévisualisation.
-        } // Fin du bloc 'if'.
+        if (ball) hwSpriteSetContent(ball); // Dessine la balle dans le sprite matériel.
+        hwSpriteSetPos(CENTER_X, CENTER_Y); // Place le sprite de la balle au centre.
+        hwSpriteSetVisible(true); // Et le rend visible pour la prévisualisation.
         if (color_menu_container) lv_obj_clear_flag(color_menu_container, LV_OBJ_FLAG_HIDDEN); // Affiche le menu de sélection de couleur.
     }, LV_EVENT_CLICKED, NULL); // Fin de la définition de l'action de clic.
 } // Fin de la fonction createMainMenu.
@@ -333,6 +333,7 @@ void createColorMenu() {
     lv_obj_set_size(color_menu_container, SCREEN_WIDTH, SCREEN_HEIGHT); // Lui donne la taille de l'écran.
     lv_obj_center(color_menu_container); // Le centre.
     lv_obj_add_flag(color_menu_container, LV_OBJ_FLAG_HIDDEN); // Le cache par défaut.
+    lv_obj_add_flag(color_menu_container, LV_OBJ_FLAG_CACHE_AS_BITMAP); // Le garde aussi dans une image, redessinée seulement quand une pastille change.
 
     lv_obj_t* color_panel = lv_obj_create(color_menu_container); // Crée un panneau pour les pastilles de couleur.
     lv_obj_set_size(color_panel, 300, 50); // Définit sa taille.
@@ -363,10 +364,8 @@ void createColorMenu() {
     lv_obj_center(backLabel); // Centre le texte dans le bouton.
     lv_obj_add_event_cb(backBtn, [](lv_event_t *e) { // Ajoute une action de clic pour le bouton "Retour".
         if (color_menu_container) lv_obj_add_flag(color_menu_container, LV_OBJ_FLAG_HIDDEN); // Cache le menu des couleurs.
-        if (ball) { // Si la balle existe...
-            lv_obj_set_pos(ball, CENTER_X, CENTER_Y); // ...la replace au centre.
-            lv_obj_add_flag(ball, LV_OBJ_FLAG_HIDDEN); // ...et la cache, car on retourne au menu principal.
-        } // Fin du bloc 'if'.
+        hwSpriteSetPos(CENTER_X, CENTER_Y); // Replace le sprite de la balle au centre.
+        hwSpriteSetVisible(false); // Et le cache, car on retourne au menu principal.
         if (main_menu_container) lv_obj_clear_flag(main_menu_container, LV_OBJ_FLAG_HIDDEN); // Affiche le menu principal.
     }, LV_EVENT_CLICKED, NULL); // Fin de l'action de clic.
 } // Fin de la fonction createColorMenu.
@@ -381,17 +380,12 @@ void initGreenCubeObject() {
     lv_obj_add_flag(greenCube, LV_OBJ_FLAG_HIDDEN); // Le cache immédiatement après sa création.
 } // Fin de la fonction initGreenCubeObject.
 
-// Définit la fonction 'spawnGreenCube', appelée par un timer.
-void spawnGreenCube(lv_timer_t *timer) {
-    if (!gameStarted || isGameOver || greenCube == NULL) return; // Ne fait rien si le jeu n'est pas en cours ou si le cube n'a pas été initialisé.
-
-    int greenCubeX = random(0, SCREEN_WIDTH - OBSTACLE_SIZE); // Choisit une coordonnée X aléatoire sur l'écran.
-    int greenCubeY = random(0, SCREEN_HEIGHT - OBSTACLE_SIZE); // Choisit une coordonnée Y aléatoire sur l'écran.
-    
-    lv_obj_set_pos(greenCube, greenCubeX, greenCubeY); // Positionne le cube à ces coordonnées.
-    lv_obj_clear_flag(greenCube, LV_OBJ_FLAG_HIDDEN); // Le rend visible en enlevant son drapeau "caché".
-
-    green_cube_spawn_timer = NULL; // Réinitialise le pointeur du timer, car ce timer est à usage unique et s'est exécuté.
+// Définit la fonction 'spawnGreenCube', appelée par la tâche du jeu.
+void spawnGreenCube() {
+    greenCubeX = random(0, SCREEN_WIDTH - OBSTACLE_SIZE); // Choisit une coordonnée X aléatoire sur l'écran.
+    greenCubeY = random(0, SCREEN_HEIGHT - OBSTACLE_SIZE); // Choisit une coordonnée Y aléatoire sur l'écran.
+    greenCubeVisible = true; // Le cube peut être ramassé, l'interface l'affichera à sa prochaine mise à jour.
+    nextGreenCubeTick = 0; // Aucune autre apparition n'est prévue.
 } // Fin de la fonction spawnGreenCube.
 
 
@@ -403,14 +397,18 @@ void testLvgl() {
     ball_color = lv_color_hex(0xFF0000); // Définit la couleur par défaut de la balle (rouge).
 
     ball = createBasicLvObject(lv_screen_active(), BALL_SIZE, BALL_SIZE, ball_color, true); // Crée l'objet balle.
-    lv_obj_add_flag(ball, LV_OBJ_FLAG_HIDDEN); // La cache par défaut, elle ne sera visible qu'en jeu.
+    lv_obj_add_flag(ball, LV_OBJ_FLAG_HIDDEN); // La cache pour LVGL : c'est le sprite matériel (couche 1 du LTDC) qui l'affiche.
     lv_obj_set_pos(ball, CENTER_X, CENTER_Y); // La positionne au centre.
+    hwSpriteSetPos(CENTER_X, CENTER_Y); // Positionne le sprite au centre, il reste caché jusqu'au début du jeu.
 
-    initObstacles(); // Appelle la fonction pour initialiser le tableau d'obstacles.
+    initObstacles(); // Appelle la fonction pour créer le widget des obstacles.
     initGreenCubeObject(); // Appelle la fonction pour créer l'objet cube vert.
 
     createColorMenu(); // Appelle la fonction pour créer les objets du menu couleur (ils sont cachés).
     createMainMenu();  // Appelle la fonction pour créer et afficher le menu principal.
+
+    ui_timer = lv_timer_create(syncUi, GAME_STEP_MS, NULL); // Recopie l'état du jeu à l'écran au rythme du jeu.
+    lv_timer_pause(ui_timer); // Seulement pendant une partie : dans les menus, rien ne réveille la tâche LVGL sans raison.
 } // Fin de la fonction testLvgl.
 
 /******************************************************************************
@@ -418,133 +416,229 @@ void testLvgl() {
  ******************************************************************************/
 // Définit la fonction 'initMPU6050'.
 void initMPU6050() {
-    Wire.begin(); // Initialise la bibliothèque Wire pour la communication I2C.
-    Wire.beginTransmission(MPU6050_ADDR); // Commence une transmission vers l'adresse du capteur.
-    Wire.write(0x6B); // Envoie l'adresse du registre de gestion de l'alimentation (Power Management 1).
-    Wire.write(0);    // Envoie la valeur 0 à ce registre pour sortir le capteur du mode veille.
-    Wire.endTransmission(true); // Termine la transmission et libère le bus I2C.
+    if (!mpu6050Begin()) { // Réveille le capteur et démarre la tâche qui le lit à chaque nouvel échantillon...
+        Serial.println("MPU6050 not found"); // ...et signale sur le port série s'il ne répond pas.
+    } // Fin du bloc 'if'.
+    tiltFilterInit(&tiltFilter); // Le filtre mesure le biais du gyroscope sur les premiers échantillons (carte immobile).
 } // Fin de la fonction initMPU6050.
 
-// Définit la fonction 'readMPU6050'.
+// Définit la fonction 'readMPU6050', qui ne parle plus au capteur : elle vide la file remplie par la tâche du capteur.
 void readMPU6050() {
-    Wire.beginTransmission(MPU6050_ADDR); // Commence une transmission vers le capteur.
-    Wire.write(0x3B); // Envoie l'adresse du premier registre de données de l'accéléromètre (ACCEL_XOUT_H).
-    Wire.endTransmission(false); // Termine la transmission mais garde la connexion active pour une lecture.
-    
-    Wire.requestFrom((uint8_t)MPU6050_ADDR, (size_t)6, true); // Demande 6 octets de données au capteur.
-    
-    if (Wire.available() >= 6) { // Si au moins 6 octets sont disponibles dans le buffer de réception...
-        accX = (Wire.read() << 8) | Wire.read(); // Lit l'octet de poids fort, le décale de 8 bits à gauche, et le combine avec l'octet de poids faible pour former la valeur 16-bit de l'axe X.
-        accY = (Wire.read() << 8) | Wire.read(); // Fait de même pour la valeur de l'axe Y.
-        Wire.read(); Wire.read(); // Lit et ignore les deux octets de l'axe Z, qui ne sont pas utilisés dans ce projet.
-    } // Fin du bloc 'if'.
+    Mpu6050Sample sample; // Un échantillon de l'accéléromètre.
+    int32_t sumX = 0, sumY = 0; // Sommes des échantillons reçus depuis la dernière image.
+    int count = 0; // Nombre d'échantillons reçus.
+
+    while (mpu6050Read(&sample)) { // Tant que la file contient des échantillons...
+        tiltFilterUpdate(&tiltFilter, &sample); // ...fait avancer le filtre d'un échantillon.
+        sumX += sample.accX; // ...accumule l'axe X.
+        sumY += sample.accY; // ...accumule l'axe Y (l'axe Z n'est pas utilisé dans ce projet).
+        count++; // ...et les compte.
+    } // Fin de la boucle 'while'.
+
+#if BALL_CONTROL_FUSED
+    accX = tiltFilterX(&tiltFilter); // Utilise l'inclinaison filtrée : réaction immédiate grâce au gyroscope, sans tremblement.
+    accY = tiltFilterY(&tiltFilter);  // Même chose pour l'axe Y.
+#else
+    if (count > 0) { // S'il y a eu de nouveaux échantillons...
+        accX = sumX / count; // ...utilise leur moyenne, moins bruitée qu'une seule lecture.
+        accY = sumY / count; // ...de même pour l'axe Y.
+    } // Fin du bloc 'if' (sinon les dernières valeurs sont gardées).
+#endif
 } // Fin de la fonction readMPU6050.
 
 /******************************************************************************
- * BOUCLE PRINCIPALE DU JEU
+ * BOUCLE PRINCIPALE DU JEU (tâche du jeu, sans LVGL)
  ******************************************************************************/
-// Définit la fonction 'gameLoop', appelée par un timer.
-void gameLoop(lv_timer_t *timer) {
+// Définit la fonction 'startGameState', qui remet le jeu à zéro pour la partie demandée par l'interface.
+void startGameState(int game) {
+    gameNumber = game; // Mémorise le numéro de la partie, recopié dans l'état publié.
+    gameStarted = true; // Indique que le jeu a commencé.
+    isGameOver = false; // Indique que ce n'est pas encore la fin de la partie.
+    ballX = CENTER_X; // Réinitialise la position X de la balle.
+    ballY = CENTER_Y; // Réinitialise la position Y de la balle.
+    collisionCount = 0; // Réinitialise le compteur de collisions.
+    score = 0; // Réinitialise le score.
+    physicsClear(&obstacleWorld); // Vide le monde physique.
+
+    uint32_t now = millis(); // Lit l'heure actuelle en millisecondes.
+    lastPhysicsTick = now; // La physique démarre maintenant.
+    nextObstacleTick = now + OBSTACLE_SPAWN_MS; // Premier obstacle dans 2 secondes.
+    nextScoreTick = now + SCORE_PERIOD_MS; // Premiers points dans 1 seconde.
+    spawnGreenCube(); // Fait apparaître le premier cube vert immédiatement.
+} // Fin de la fonction startGameState.
+
+// Définit la fonction 'loseLife', appelée quand la balle touche un bord ou un obstacle.
+void loseLife() {
+    collisionCount++; // Incrémente le compteur de vies perdues.
+    physicsClear(&obstacleWorld); // Efface tous les obstacles.
+
+    if (collisionCount >= MAX_COLLISIONS) { // Si le joueur n'a plus de vies...
+        gameStarted = false; // ...arrête la simulation...
+        isGameOver = true; // ...et annonce la fin de la partie à l'interface.
+    } else { // Sinon...
+        ballX = CENTER_X; // ...replace la balle au centre.
+        ballY = CENTER_Y; // ...replace la balle au centre.
+    } // Fin du bloc if/else.
+} // Fin de la fonction loseLife.
+
+// Définit la fonction 'gameStep', un pas de simulation de GAME_STEP_MS.
+void gameStep() {
     if (!gameStarted || isGameOver) return; // Quitte si le jeu n'est pas en cours.
 
-    readMPU6050(); // Lit les dernières valeurs du capteur d'inclinaison.
+    uint32_t now = millis(); // Lit l'heure actuelle en millisecondes.
+    if ((int32_t)(now - nextObstacleTick) >= 0) { // S'il est temps de créer un obstacle...
+        createObstacle(); // ...le crée...
+        nextObstacleTick += OBSTACLE_SPAWN_MS; // ...et programme le suivant.
+    } // Fin du bloc 'if'.
+    if ((int32_t)(now - nextScoreTick) >= 0) { // S'il est temps de gagner des points...
+        score += 10; // ...ajoute 10 points au score...
+        nextScoreTick += SCORE_PERIOD_MS; // ...et programme le prochain gain.
+    } // Fin du bloc 'if'.
+    if (nextGreenCubeTick != 0 && (int32_t)(now - nextGreenCubeTick) >= 0) { // S'il est temps de faire réapparaître le cube vert...
+        spawnGreenCube(); // ...le fait apparaître.
+    } // Fin du bloc 'if'.
 
     float factor = 0.0006; // Définit un facteur de sensibilité pour le mouvement.
     ballX += accY * factor; // Met à jour la position X de la balle en fonction de l'inclinaison sur l'axe Y du capteur (axes inversés).
     ballY += accX * factor; // Met à jour la position Y de la balle en fonction de l'inclinaison sur l'axe X du capteur.
 
     if (ballX <= 0 || ballX >= SCREEN_WIDTH - BALL_SIZE || ballY <= 0 || ballY >= SCREEN_HEIGHT - BALL_SIZE) { // Vérifie si la balle touche un des quatre bords de l'écran.
-        collisionCount++; // Incrémente le compteur de vies perdues.
-        updateLifeLabel(); // Met à jour l'affichage des vies.
-        clearObstacles(); // Efface tous les obstacles.
-
-        if (collisionCount >= MAX_COLLISIONS) { // Si le joueur n'a plus de vies...
-            gameOver(); // ...déclenche la fin de la partie.
-        } else { // Sinon...
-            ballX = CENTER_X; // ...replace la balle au centre.
-            ballY = CENTER_Y; // ...replace la balle au centre.
-            if (ball) lv_obj_set_pos(ball, ballX, ballY); // Applique la nouvelle position.
-        } // Fin du bloc if/else.
-        return; // Quitte la fonction pour cette frame, car la balle a été réinitialisée.
+        loseLife(); // Perd une vie (et replace la balle ou termine la partie).
+        return; // Quitte la fonction pour ce pas, car la balle a été réinitialisée.
     } // Fin du bloc if pour la collision avec les bords.
 
-    if (ball) lv_obj_set_pos(ball, ballX, ballY); // Applique la nouvelle position de la balle à son objet graphique.
-
     float ballCenterX = ballX + BALL_SIZE / 2.0f; // Calcule la coordonnée X du centre de la balle.
     float ballCenterY = ballY + BALL_SIZE / 2.0f; // Calcule la coordonnée Y du centre de la balle.
     float ballRadius = BALL_SIZE / 2.0f; // Calcule le rayon de la balle.
 
     // --- Détection de collision avec le cube vert ---
-    if (greenCube != NULL && !lv_obj_has_flag(greenCube, LV_OBJ_FLAG_HIDDEN)) { // Si le cube vert existe et est visible...
-        lv_area_t greenCubeArea; // Crée une structure pour stocker les coordonnées du cube.
-        lv_obj_get_coords(greenCube, &greenCubeArea); // Récupère les coordonnées du cube.
-
-        float closestXGreen = clamp(ballCenterX, (float)greenCubeArea.x1, (float)greenCubeArea.x2); // Trouve le point X sur le cube le plus proche du centre de la balle.
-        float closestYGreen = clamp(ballCenterY, (float)greenCubeArea.y1, (float)greenCubeArea.y2); // Trouve le point Y sur le cube le plus proche du centre de la balle.
-        float distXGreen = ballCenterX - closestXGreen; // Calcule la distance en X entre la balle et ce point.
-        float distYGreen = ballCenterY - closestYGreen; // Calcule la distance en Y entre la balle et ce point.
-        float distanceSquaredGreen = (distXGreen * distXGreen) + (distYGreen * distYGreen); // Calcule la distance au carré pour éviter une racine carrée coûteuse.
-
-        if (distanceSquaredGreen < (ballRadius * ballRadius)) { // Si la distance au carré est inférieure au rayon au carré, il y a collision.
+    if (greenCubeVisible) { // Si le cube vert est affiché...
+        if (physicsCircleHitsBox(ballCenterX, ballCenterY, ballRadius, greenCubeX, greenCubeY, OBSTACLE_SIZE, OBSTACLE_SIZE)) { // Si la balle touche le cube (test cercle contre rectangle)...
             score += 100; // Ajoute 100 points au score.
-            if (scoreLabel) { // Si le label du score existe...
-                char buf[32]; // ...crée un buffer.
-                snprintf(buf, sizeof(buf), "Score : %d", score); // ...formate le nouveau score.
-                lv_label_set_text(scoreLabel, buf); // ...et met à jour le texte.
-            } // Fin du bloc 'if'.
-            lv_obj_add_flag(greenCube, LV_OBJ_FLAG_HIDDEN); // Cache le cube vert.
-
-            if (green_cube_spawn_timer) { // S'il y a un timer d'apparition en attente...
-                lv_timer_del(green_cube_spawn_timer); // ...le supprime.
-                green_cube_spawn_timer = NULL; // ...et réinitialise le pointeur.
-            } // Fin du bloc 'if'.
-            green_cube_spawn_timer = lv_timer_create(spawnGreenCube, 5000, NULL); // Programme l'apparition du prochain cube dans 5 secondes.
-            lv_timer_set_repeat_count(green_cube_spawn_timer, 1); // Ce timer ne s'exécutera qu'une fois.
+            greenCubeVisible = false; // Cache le cube vert.
+            nextGreenCubeTick = now + GREEN_CUBE_DELAY_MS; // Programme l'apparition du prochain cube dans 5 secondes.
         } // Fin du bloc 'if' de collision.
     } // Fin du bloc 'if' de vérification du cube vert.
 
     // --- Mouvement et collision des obstacles bleus ---
-    for (int i = 0; i < MAX_OBSTACLES; i++) { // Boucle pour parcourir tous les obstacles possibles.
-        if (obstacles[i].obj != NULL) { // Si un obstacle existe à cet emplacement...
-            obstacles[i].x_pos += obstacles[i].dx; // ...met à jour sa position X en fonction de sa vitesse.
-            obstacles[i].y_pos += obstacles[i].dy; // ...met à jour sa position Y en fonction de sa vitesse.
-
-            if ((obstacles[i].x_pos <= 0 && obstacles[i].dx < 0) || (obstacles[i].x_pos >= SCREEN_WIDTH - OBSTACLE_SIZE && obstacles[i].dx > 0)) { // S'il touche un bord vertical...
-                obstacles[i].dx *= -1; // ...inverse sa direction horizontale pour le faire rebondir.
-            } // Fin du bloc 'if'.
-            if ((obstacles[i].y_pos <= 0 && obstacles[i].dy < 0) || (obstacles[i].y_pos >= SCREEN_HEIGHT - OBSTACLE_SIZE && obstacles[i].dy > 0)) { // S'il touche un bord horizontal...
-                obstacles[i].dy *= -1; // ...inverse sa direction verticale.
+    physicsAdvance(&obstacleWorld, now - lastPhysicsTick); // Avance la physique par pas fixes de PHYSICS_STEP_MS.
+    lastPhysicsTick = now; // Mémorise l'heure de ce passage.
+
+    if (physicsCollideCircle(&obstacleWorld, ballCenterX, ballCenterY, ballRadius) >= 0) { // Si la balle touche un des obstacles...
+        loseLife(); // ...perd une vie.
+    } // Fin du bloc 'if' de collision.
+} // Fin de la fonction gameStep.
+
+// Définit la fonction 'publishGameView', qui recopie l'état du jeu pour l'interface.
+void publishGameView() {
+    GameView *view = gameView.writeBuffer(); // Tampon libre : ni l'interface ni le pas précédent ne l'utilisent.
+    view->game = gameNumber; // Numéro de la partie.
+    view->playing = gameStarted; // Partie en cours.
+    view->over = isGameOver; // Partie terminée.
+    view->ballX = ballX; // Position X de la balle.
+    view->ballY = ballY; // Position Y de la balle.
+    view->lives = MAX_COLLISIONS - collisionCount; // Vies restantes.
+    view->score = score; // Score.
+    view->greenCubeVisible = greenCubeVisible; // Cube vert affiché ou non.
+    view->greenCubeX = greenCubeX; // Position X du cube vert.
+    view->greenCubeY = greenCubeY; // Position Y du cube vert.
+    view->obstacleCount = obstacleWorld.count; // Nombre d'obstacles.
+    memcpy(view->obstacleX, obstacleWorld.x, obstacleWorld.count * sizeof(float)); // Positions X des obstacles.
+    memcpy(view->obstacleY, obstacleWorld.y, obstacleWorld.count * sizeof(float)); // Positions Y des obstacles.
+    gameView.publish(); // Rend cet état visible à l'interface d'un seul coup.
+} // Fin de la fonction publishGameView.
+
+// Définit la tâche du jeu 'myTask', démarrée par les pilotes au-dessus de la tâche LVGL.
+void myTask(void *pvParameters) {
+    TickType_t lastWake = xTaskGetTickCount(); // Heure de référence pour un rythme fixe.
+
+    while (1) { // Boucle infinie de la tâche.
+        int game; // Numéro de partie reçu de l'interface.
+        if (gameStarted) { // Pendant une partie...
+            if (xQueueReceive(gameCommands, &game, 0) == pdTRUE) { // ...si l'interface a demandé une nouvelle partie...
+                startGameState(game); // ...remet le jeu à zéro.
             } // Fin du bloc 'if'.
+        } else if (xQueueReceive(gameCommands, &game, pdMS_TO_TICKS(MENU_SENSOR_MS)) == pdTRUE) { // Hors partie, dort jusqu'à un ordre de l'interface (ou le prochain vidage du capteur)...
+            startGameState(game); // ...remet le jeu à zéro.
+            lastWake = xTaskGetTickCount(); // Le rythme fixe repart de maintenant.
+        } // Fin du bloc if/else.
 
-            lv_obj_set_pos(obstacles[i].obj, (lv_coord_t)obstacles[i].x_pos, (lv_coord_t)obstacles[i].y_pos); // Applique la nouvelle position à l'objet graphique.
-
-            lv_area_t obsArea; // Crée une structure pour les coordonnées de l'obstacle.
-            lv_obj_get_coords(obstacles[i].obj, &obsArea); // Récupère ses coordonnées.
-
-            float closestX = clamp(ballCenterX, (float)obsArea.x1, (float)obsArea.x2); // Trouve le point X sur l'obstacle le plus proche du centre de la balle.
-            float closestY = clamp(ballCenterY, (float)obsArea.y1, (float)obsArea.y2); // Trouve le point Y sur l'obstacle le plus proche du centre de la balle.
-            float distX = ballCenterX - closestX; // Calcule la distance en X.
-            float distY = ballCenterY - closestY; // Calcule la distance en Y.
-            float distanceSquared = (distX * distX) + (distY * distY); // Calcule la distance au carré.
+        readMPU6050(); // Vide toujours la file du capteur, pour que le filtre d'inclinaison reste à jour même dans les menus.
+        if (!gameStarted) continue; // Rien d'autre à faire hors partie : le processeur peut dormir (tickless idle).
 
-            if (distanceSquared < (ballRadius * ballRadius)) { // S'il y a collision...
-                collisionCount++; // ...incrémente le compteur de vies perdues.
-                updateLifeLabel(); // ...met à jour l'affichage.
-                clearObstacles(); // ...efface tous les obstacles.
+        gameStep(); // Fait avancer le jeu d'un pas.
+        publishGameView(); // Publie le nouvel état pour l'interface.
 
-                if (collisionCount >= MAX_COLLISIONS) { // Si le joueur n'a plus de vies...
-                    gameOver(); // ...déclenche la fin du jeu.
-                } else { // Sinon...
-                    ballX = CENTER_X; // ...replace la balle au centre.
-                    ballY = CENTER_Y; // ...replace la balle au centre.
-                    if (ball) lv_obj_set_pos(ball, ballX, ballY); // Applique sa nouvelle position.
-                } // Fin du bloc if/else.
-                return; // Quitte la fonction pour cette frame.
-            } // Fin du bloc 'if' de collision.
-        } // Fin du bloc 'if' de vérification de l'obstacle.
-    } // Fin de la boucle 'for' des obstacles.
-} // Fin de la fonction gameLoop.
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(GAME_STEP_MS)); // Attend le prochain pas : 50 Hz, même pendant un long rendu.
+    } // Fin de la boucle 'while'.
+} // Fin de la fonction myTask.
 
+#if PHYSICS_BENCHMARK
+/******************************************************************************
+ * MESURE DES PERFORMANCES DE LA PHYSIQUE (env:disco_f746ng_physics_bench)
+ ******************************************************************************/
+static PhysicsWorld benchWorld; // Monde de test, séparé de celui du jeu (statique car trop gros pour la pile).
+
+// Définit la fonction 'benchmarkPhysics', qui compare la grille et le parcours par paquets au parcours d'origine et affiche les temps sur le port série.
+void benchmarkPhysics() {
+    const int counts[] = {50, 200, PHYSICS_MAX_BODIES}; // Nombres d'obstacles testés.
+    const int queries = 1000; // Nombre de tests de collision de la balle mesurés pour chaque cas.
+    const int steps = 100;    // Nombre de pas de simulation mesurés pour chaque cas.
+
+    int mismatches = 0; // Vérifie d'abord que le noyau optimisé (FPU ou SSE/AVX) donne les mêmes collisions que la version portable.
+    for (int b = 0; b < 1000; b++) { // Sur 1000 paquets de boîtes aléatoires...
+        float boxX[PHYSICS_BATCH_SIZE], boxY[PHYSICS_BATCH_SIZE]; // ...des coins de boîtes répartis autour de l'écran.
+        for (int i = 0; i < PHYSICS_BATCH_SIZE; i++) {
+            boxX[i] = random(-OBSTACLE_SIZE * 100, (SCREEN_WIDTH + OBSTACLE_SIZE) * 100) / 100.0f; // Coordonnée X au centième de pixel.
+            boxY[i] = random(-OBSTACLE_SIZE * 100, (SCREEN_HEIGHT + OBSTACLE_SIZE) * 100) / 100.0f; // Coordonnée Y au centième de pixel.
+        } // Fin de la boucle de remplissage du paquet.
+        int count = 1 + b % PHYSICS_BATCH_SIZE; // Teste aussi les paquets incomplets.
+        float cx = random(0, SCREEN_WIDTH), cy = random(0, SCREEN_HEIGHT); // Position aléatoire de la balle.
+        mismatches += physicsCircleHitsBoxes(boxX, boxY, count, OBSTACLE_SIZE, cx, cy, BALL_SIZE / 2.0f) !=
+                      physicsCircleHitsBoxesScalar(boxX, boxY, count, OBSTACLE_SIZE, cx, cy, BALL_SIZE / 2.0f); // Compare les deux masques.
+    } // Fin de la boucle de vérification.
+    Serial.printf("batch kernel: %d mismatches\n", mismatches); // Affiche le résultat de la vérification.
+
+    for (int c = 0; c < 3; c++) { // Pour chaque nombre d'obstacles...
+        physicsInit(&benchWorld, SCREEN_WIDTH, SCREEN_HEIGHT, OBSTACLE_SIZE); // ...repart d'un monde vide.
+        for (int i = 0; i < counts[c]; i++) { // ...le remplit d'obstacles à des positions et vitesses aléatoires.
+            physicsAdd(&benchWorld, random(0, SCREEN_WIDTH - OBSTACLE_SIZE), random(0, SCREEN_HEIGHT - OBSTACLE_SIZE),
+                       random(-15, 16) / 10.0f, random(-15, 16) / 10.0f);
+        } // Fin de la boucle de remplissage.
+
+        int hitsScalar = 0, hitsScan = 0, hitsGrid = 0; // Compte les collisions trouvées, pour vérifier que les trois méthodes sont d'accord.
+        uint32_t start = micros(); // Démarre le chronomètre.
+        for (int q = 0; q < queries; q++) { // Teste la balle à des positions pseudo-aléatoires avec le parcours d'origine, obstacle par obstacle.
+            hitsScalar += physicsCollideCircleScanScalar(&benchWorld, (q * 37) % SCREEN_WIDTH, (q * 53) % SCREEN_HEIGHT, BALL_SIZE / 2.0f) >= 0;
+        } // Fin de la boucle du parcours d'origine.
+        uint32_t scalarUs = micros() - start; // Temps total du parcours d'origine : la référence.
+
+        start = micros(); // Redémarre le chronomètre.
+        for (int q = 0; q < queries; q++) { // Mêmes positions, avec le parcours linéaire par paquets.
+            hitsScan += physicsCollideCircleScan(&benchWorld, (q * 37) % SCREEN_WIDTH, (q * 53) % SCREEN_HEIGHT, BALL_SIZE / 2.0f) >= 0;
+        } // Fin de la boucle du parcours par paquets.
+        uint32_t scanUs = micros() - start; // Temps total du parcours par paquets.
+
+        start = micros(); // Redémarre le chronomètre.
+        for (int q = 0; q < queries; q++) { // Mêmes positions, toujours avec la grille (physicsCollideCircle passerait au parcours sous PHYSICS_GRID_MIN_BODIES).
+            hitsGrid += physicsCollideCircleGrid(&benchWorld, (q * 37) % SCREEN_WIDTH, (q * 53) % SCREEN_HEIGHT, BALL_SIZE / 2.0f) >= 0;
+        } // Fin de la boucle de la grille.
+        uint32_t gridUs = micros() - start; // Temps total avec la grille.
+        bool mismatch = hitsScan != hitsScalar || hitsGrid != hitsScalar; // Les trois méthodes doivent trouver les mêmes collisions.
+
+        physicsSetBodyCollisions(&benchWorld, true); // Mesure aussi un pas complet avec les rebonds entre obstacles.
+        start = micros(); // Redémarre le chronomètre.
+        for (int i = 0; i < steps; i++) { // Fait avancer la simulation.
+            physicsStep(&benchWorld);
+        } // Fin de la boucle de simulation.
+        uint32_t stepUs = micros() - start; // Temps total de simulation.
+
+        Serial.printf("%d bodies: ball scalar scan %lu ns, ball batched scan %lu ns, ball grid %lu ns, step with body collisions %lu us%s\n",
+                      counts[c], scalarUs * 1000 / queries, scanUs * 1000 / queries, gridUs * 1000 / queries, stepUs / steps,
+                      mismatch ? " (MISMATCH)" : ""); // Affiche les temps moyens.
+    } // Fin de la boucle des cas de test.
+} // Fin de la fonction benchmarkPhysics.
+#endif // PHYSICS_BENCHMARK
 
 /******************************************************************************
  * FONCTIONS PRINCIPALES ARDUINO
@@ -553,6 +647,15 @@ void gameLoop(lv_timer_t *timer) {
 void mySetup() {
     Serial.begin(115200); // Initialise la communication série (pour le débogage via le moniteur série) à une vitesse de 115200 bauds.
     randomSeed(analogRead(0)); // Initialise le générateur de nombres aléatoires avec une valeur imprévisible lue sur une broche analogique non connectée.
+#if PHYSICS_BENCHMARK
+    benchmarkPhysics(); // Mesure la physique avant de lancer le jeu.
+#endif
+#if BLEND_BENCHMARK
+    blendBenchmark(); // Vérifie et mesure les mélanges de pixels de LVGL avant de lancer l'interface.
+#endif
+    physicsInit(&obstacleWorld, SCREEN_WIDTH, SCREEN_HEIGHT, OBSTACLE_SIZE); // Prépare un monde physique vide de la taille de l'écran.
+    physicsSetBodyCollisions(&obstacleWorld, OBSTACLES_COLLIDE); // Active ou non les rebonds entre obstacles.
+    gameCommands = xQueueCreate(4, sizeof(int)); // Crée la file des ordres de l'interface vers le jeu.
     testLvgl();      // Appelle la fonction qui met en place toute l'interface graphique initiale.
     initMPU6050();   // Appelle la fonction qui configure et réveille le capteur MPU6050.
 } // Fin de la fonction mySetup.
@@ -560,6 +663,6 @@ void mySetup() {
 // Définit la fonction 'loop', qui s'exécute en continu après 'mySetup'.
 void loop() {
     // Cette fonction est intentionnellement laissée vide dans ce projet.
-    // Toute la logique du jeu est gérée par les 'timers' de LVGL (comme 'gameLoop').
-    // Le framework qui utilise ce code est responsable d'appeler périodiquement 'lv_timer_handler()' pour que LVGL fonctionne.
+    // La logique du jeu tourne dans 'myTask', l'affichage dans les timers de LVGL (comme 'syncUi').
+    // Le framework qui utilise ce code crée ces deux tâches et appelle périodiquement 'lv_timer_handler()'.
 } // Fin de la fonction loop.
\ No newline at end of file
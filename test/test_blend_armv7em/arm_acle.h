@@ -0,0 +1,47 @@
+#ifndef HOST_ARM_ACLE_H
+#define HOST_ARM_ACLE_H
+
+// The ACLE DSP intrinsics used by the ARMv7E-M blend back-end, in portable C, so that it builds and
+// can be checked on the host (env:native_blend). Same results as the instructions, the Q and GE
+// flags aside.
+
+#include <stdint.h>
+
+// UXTB16: bytes 0 and 2 zero extended to the two halfwords
+static inline uint32_t __uxtb16(uint32_t x)
+{
+    return x & 0x00FF00FF;
+}
+
+// SMLAD: the two signed halfword products added to the accumulator
+static inline int32_t __smlad(uint32_t x, uint32_t y, int32_t acc)
+{
+    return acc + (int16_t)x * (int16_t)y + (int16_t)(x >> 16) * (int16_t)(y >> 16);
+}
+
+// UQADD8: bytewise unsigned add saturating to 255
+static inline uint32_t __uqadd8(uint32_t x, uint32_t y)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        uint32_t sum = ((x >> shift) & 0xFF) + ((y >> shift) & 0xFF);
+        result |= (sum > 0xFF ? 0xFF : sum) << shift;
+    }
+    return result;
+}
+
+// UQSUB8: bytewise unsigned subtraction saturating to 0
+static inline uint32_t __uqsub8(uint32_t x, uint32_t y)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        uint32_t a = (x >> shift) & 0xFF;
+        uint32_t b = (y >> shift) & 0xFF;
+        result |= (a > b ? a - b : 0) << shift;
+    }
+    return result;
+}
+
+#endif // HOST_ARM_ACLE_H
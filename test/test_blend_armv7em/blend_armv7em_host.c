@@ -0,0 +1,4 @@
+/* The ARMv7E-M blend back-end built on the host next to the C loops of the library (LV_DRAW_SW_ASM_NONE),
+ * its intrinsics emulated by arm_acle.h. Only its own functions are compiled here.*/
+#define LV_USE_DRAW_SW_ASM LV_DRAW_SW_ASM_ARMV7EM
+#include "src/draw/sw/blend/armv7em/lv_blend_armv7em.c"
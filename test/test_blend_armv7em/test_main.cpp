@@ -0,0 +1,287 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "src/draw/sw/blend/armv7em/lv_blend_armv7em.h"
+
+// Checks every ARMv7E-M DSP blend loop (LV_DRAW_SW_ASM_ARMV7EM) against the C loops of LVGL, bit by
+// bit, on random areas: sizes, strides and alignments of the destination, the mask and the source.
+// The intrinsics are emulated on the host: this checks the arithmetic, not the cycles
+// (env:disco_f746ng_blend_bench measures them on the board).
+
+#define MAX_WIDTH 41
+#define MAX_HEIGHT 4
+#define MAX_PAD 3
+
+// Words, so that the areas can be placed at any 1, 2 or 4 byte offset
+#define BUF_WORDS ((MAX_WIDTH + MAX_PAD) * MAX_HEIGHT + 4)
+
+#define RUNS 4000
+
+typedef lv_result_t (*FillLoop)(lv_draw_sw_blend_fill_dsc_t *dsc);
+typedef lv_result_t (*ImageLoop)(lv_draw_sw_blend_image_dsc_t *dsc);
+
+struct BlendCase
+{
+    const char *name;
+    lv_color_format_t dest;
+    lv_color_format_t src; // LV_COLOR_FORMAT_UNKNOWN: a fill
+    bool masked;
+    bool opa; // Blended with an opacity below LV_OPA_MAX
+    FillLoop fill;
+    ImageLoop image;
+};
+
+static const BlendCase cases[] = {
+    {"rgb565 opa fill", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, false, true,
+     lv_color_blend_to_rgb565_with_opa_armv7em, NULL},
+    {"rgb565 masked fill", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, true, false,
+     lv_color_blend_to_rgb565_with_mask_armv7em, NULL},
+    {"rgb565 masked opa fill", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, true, true,
+     lv_color_blend_to_rgb565_mix_mask_opa_armv7em, NULL},
+    {"rgb565 rgb565 image opa", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565, false, true, NULL,
+     lv_rgb565_blend_normal_to_rgb565_with_opa_armv7em},
+    {"rgb565 rgb565 image masked", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565, true, false, NULL,
+     lv_rgb565_blend_normal_to_rgb565_with_mask_armv7em},
+    {"rgb565 rgb565 image masked opa", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565, true, true, NULL,
+     lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_armv7em},
+    {"rgb565 argb8888 image", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, false, false, NULL,
+     lv_argb8888_blend_normal_to_rgb565_armv7em},
+    {"rgb565 argb8888 image opa", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, false, true, NULL,
+     lv_argb8888_blend_normal_to_rgb565_with_opa_armv7em},
+    {"rgb565 argb8888 image masked", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, true, false, NULL,
+     lv_argb8888_blend_normal_to_rgb565_with_mask_armv7em},
+    {"rgb565 argb8888 image masked opa", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, true, true, NULL,
+     lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_armv7em},
+    {"argb8888 opa fill", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, false, true,
+     lv_color_blend_to_argb8888_with_opa_armv7em, NULL},
+    {"argb8888 masked fill", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, true, false,
+     lv_color_blend_to_argb8888_with_mask_armv7em, NULL},
+    {"argb8888 masked opa fill", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, true, true,
+     lv_color_blend_to_argb8888_mix_mask_opa_armv7em, NULL},
+    {"argb8888 argb8888 image", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, false, false, NULL,
+     lv_argb8888_blend_normal_to_argb8888_armv7em},
+    {"argb8888 argb8888 image opa", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, false, true, NULL,
+     lv_argb8888_blend_normal_to_argb8888_with_opa_armv7em},
+    {"argb8888 argb8888 image masked", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, true, false, NULL,
+     lv_argb8888_blend_normal_to_argb8888_with_mask_armv7em},
+    {"argb8888 argb8888 image masked opa", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, true, true, NULL,
+     lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_armv7em},
+};
+
+static uint32_t background[BUF_WORDS];
+static uint32_t expected[BUF_WORDS];
+static uint32_t actual[BUF_WORDS];
+static uint32_t src[BUF_WORDS];
+static uint32_t mask[BUF_WORDS];
+
+static int randomInt(int min, int max)
+{
+    return min + rand() % (max - min + 1);
+}
+
+// Mostly the limits, where the loops take their shortcuts
+static uint8_t randomOpa(void)
+{
+    static const uint8_t edges[] = {0, 1, 2, 3, 4, 251, 252, 253, 254, 255};
+    switch (rand() % 4)
+    {
+    case 0:
+        return 0;
+    case 1:
+        return 255;
+    case 2:
+        return edges[rand() % sizeof(edges)];
+    default:
+        return rand() % 256;
+    }
+}
+
+static uint32_t randomArgb(void)
+{
+    return ((uint32_t)randomOpa() << 24) | ((uint32_t)rand() & 0xFFFFFF);
+}
+
+// Random pixels, with runs of equal mask values and pixels to reach the 2 and 4 pixel shortcuts
+static void randomContent(void)
+{
+    uint8_t *mask8 = (uint8_t *)mask;
+    int i = 0;
+    while (i < BUF_WORDS)
+    {
+        uint32_t bg = randomArgb();
+        uint32_t s = randomArgb();
+        uint8_t m = randomOpa();
+        for (int run = randomInt(1, 8); run > 0 && i < BUF_WORDS; run--, i++)
+        {
+            background[i] = bg;
+            src[i] = s;
+            memset(&mask8[i * 4], m, 4);
+        }
+    }
+}
+
+// Blends the case with the C loops into `expected` and with the DSP loop into `actual`.
+// Returns false if the DSP loop declined the area.
+static bool blendBoth(const BlendCase &c, int w, int h, int destOfs, int destPad, int srcOfs, int srcPad, int maskOfs,
+                      int maskPad, lv_opa_t opa, lv_color_t color)
+{
+    uint32_t destPx = lv_color_format_get_size(c.dest);
+    memcpy(expected, background, sizeof(expected));
+    memcpy(actual, background, sizeof(actual));
+
+    lv_result_t result;
+    if (c.src == LV_COLOR_FORMAT_UNKNOWN)
+    {
+        lv_draw_sw_blend_fill_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.dest_w = w;
+        dsc.dest_h = h;
+        dsc.dest_stride = (w + destPad) * destPx;
+        dsc.mask_buf = c.masked ? (uint8_t *)mask + maskOfs : NULL;
+        dsc.mask_stride = w + maskPad;
+        dsc.color = color;
+        dsc.opa = opa;
+
+        dsc.dest_buf = (uint8_t *)expected + destOfs;
+        if (c.dest == LV_COLOR_FORMAT_RGB565)
+        {
+            lv_draw_sw_blend_color_to_rgb565(&dsc);
+        }
+        else
+        {
+            lv_draw_sw_blend_color_to_argb8888(&dsc);
+        }
+
+        dsc.dest_buf = (uint8_t *)actual + destOfs;
+        result = c.fill(&dsc);
+    }
+    else
+    {
+        lv_draw_sw_blend_image_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.dest_w = w;
+        dsc.dest_h = h;
+        dsc.dest_stride = (w + destPad) * destPx;
+        dsc.mask_buf = c.masked ? (uint8_t *)mask + maskOfs : NULL;
+        dsc.mask_stride = w + maskPad;
+        dsc.src_buf = (uint8_t *)src + srcOfs;
+        dsc.src_stride = (w + srcPad) * lv_color_format_get_size(c.src);
+        dsc.src_color_format = c.src;
+        dsc.opa = opa;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+        dsc.dest_buf = (uint8_t *)expected + destOfs;
+        if (c.dest == LV_COLOR_FORMAT_RGB565)
+        {
+            lv_draw_sw_blend_image_to_rgb565(&dsc);
+        }
+        else
+        {
+            lv_draw_sw_blend_image_to_argb8888(&dsc);
+        }
+
+        dsc.dest_buf = (uint8_t *)actual + destOfs;
+        result = c.image(&dsc);
+    }
+
+    return result == LV_RESULT_OK;
+}
+
+static void checkCase(const BlendCase &c)
+{
+    bool rgb565 = c.dest == LV_COLOR_FORMAT_RGB565;
+
+    for (int run = 0; run < RUNS; run++)
+    {
+        randomContent();
+
+        int w = randomInt(1, MAX_WIDTH);
+        int h = randomInt(1, MAX_HEIGHT);
+        // RGB565 areas start on any halfword, ARGB8888 ones are always word aligned (draw buffers)
+        int destOfs = rgb565 ? 2 * randomInt(0, 1) : 0;
+        int destPad = randomInt(0, MAX_PAD);
+        int maskOfs = randomInt(0, 3);
+        int maskPad = randomInt(0, MAX_PAD);
+        int srcOfs = c.src == LV_COLOR_FORMAT_RGB565 ? 2 * randomInt(0, 1) : 0;
+        int srcPad = randomInt(0, MAX_PAD);
+        // The callers never blend below LV_OPA_MIN, and only pass LV_OPA_COVER to the loops without opacity
+        lv_opa_t opa = c.opa ? randomInt(LV_OPA_MIN + 1, LV_OPA_MAX - 1) : LV_OPA_COVER;
+        if (c.opa && run % 4 == 0)
+        {
+            opa = run % 8 == 0 ? LV_OPA_MIN + 1 : LV_OPA_MAX - 1;
+        }
+        lv_color_t color = lv_color_hex(rand() & 0xFFFFFF);
+
+        TEST_ASSERT_TRUE_MESSAGE(blendBoth(c, w, h, destOfs, destPad, srcOfs, srcPad, maskOfs, maskPad, opa, color),
+                                 c.name);
+
+        char message[160];
+        snprintf(message, sizeof(message), "%s: %dx%d, dest +%d/%d, src +%d/%d, mask +%d/%d, opa %d", c.name, w, h,
+                 destOfs, destPad, srcOfs, srcPad, maskOfs, maskPad, opa);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected, actual, sizeof(expected), message);
+    }
+}
+
+void setUp(void)
+{
+    srand(1234);
+}
+
+void tearDown(void)
+{
+}
+
+void test_rgb565_loops(void)
+{
+    for (size_t n = 0; n < sizeof(cases) / sizeof(cases[0]); n++)
+    {
+        if (cases[n].dest == LV_COLOR_FORMAT_RGB565)
+        {
+            checkCase(cases[n]);
+        }
+    }
+}
+
+void test_argb8888_loops(void)
+{
+    for (size_t n = 0; n < sizeof(cases) / sizeof(cases[0]); n++)
+    {
+        if (cases[n].dest == LV_COLOR_FORMAT_ARGB8888)
+        {
+            checkCase(cases[n]);
+        }
+    }
+}
+
+void test_unaligned_argb8888_source_declined(void)
+{
+    // An ARGB8888 source off a word boundary is left to the C loops, the destination untouched
+    for (size_t n = 0; n < sizeof(cases) / sizeof(cases[0]); n++)
+    {
+        const BlendCase &c = cases[n];
+        if (c.src != LV_COLOR_FORMAT_ARGB8888)
+        {
+            continue;
+        }
+
+        randomContent();
+        TEST_ASSERT_FALSE_MESSAGE(blendBoth(c, 16, 2, 0, 0, 2, 0, 0, 0, c.opa ? LV_OPA_50 : LV_OPA_COVER,
+                                            lv_color_hex(0x3A7FD5)),
+                                  c.name);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(background, actual, sizeof(actual), c.name);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rgb565_loops);
+    RUN_TEST(test_argb8888_loops);
+    RUN_TEST(test_unaligned_argb8888_source_declined);
+    return UNITY_END();
+}
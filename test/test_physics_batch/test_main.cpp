@@ -0,0 +1,157 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "gamePhysics.h"
+
+// Playfield and sizes of the game
+#define FIELD_WIDTH 480.0f
+#define FIELD_HEIGHT 272.0f
+#define BOX_SIZE 30.0f
+#define BALL_RADIUS 10.0f
+
+static PhysicsWorld world;
+
+static float randomFloat(float min, float max)
+{
+    return min + (max - min) * (float)rand() / (float)RAND_MAX;
+}
+
+static void assertSameMasks(const float *x, const float *y, int count, float size, float cx, float cy, float r)
+{
+    // The scalar fallback, the kernel of this target (SSE/AVX on the host) and the Cortex-M7 one
+    uint32_t expected = physicsCircleHitsBoxesScalar(x, y, count, size, cx, cy, r);
+    uint32_t actual = physicsCircleHitsBoxes(x, y, count, size, cx, cy, r);
+    uint32_t unrolled = physicsCircleHitsBoxesUnrolled(x, y, count, size, cx, cy, r);
+
+    char message[96];
+    snprintf(message, sizeof(message), "count %d, circle (%g, %g) r %g", count, cx, cy, r);
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected, actual, message);
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected, unrolled, message);
+}
+
+void setUp(void)
+{
+    srand(1234);
+}
+
+void tearDown(void)
+{
+}
+
+void test_random_batches(void)
+{
+    float x[PHYSICS_BATCH_SIZE];
+    float y[PHYSICS_BATCH_SIZE];
+
+    for (int b = 0; b < 20000; b++)
+    {
+        for (int i = 0; i < PHYSICS_BATCH_SIZE; i++)
+        {
+            x[i] = randomFloat(-BOX_SIZE, FIELD_WIDTH + BOX_SIZE);
+            y[i] = randomFloat(-BOX_SIZE, FIELD_HEIGHT + BOX_SIZE);
+        }
+
+        // Every length from empty to full, so the tails after the 8 and 4 wide loops are covered
+        int count = b % (PHYSICS_BATCH_SIZE + 1);
+        assertSameMasks(x, y, count, BOX_SIZE, randomFloat(0, FIELD_WIDTH), randomFloat(0, FIELD_HEIGHT), BALL_RADIUS);
+    }
+}
+
+void test_dense_batches(void)
+{
+    float x[PHYSICS_BATCH_SIZE];
+    float y[PHYSICS_BATCH_SIZE];
+
+    // Boxes packed around the circle, most of them hit: the masks have most bits set
+    for (int b = 0; b < 5000; b++)
+    {
+        float cx = randomFloat(0, FIELD_WIDTH);
+        float cy = randomFloat(0, FIELD_HEIGHT);
+        for (int i = 0; i < PHYSICS_BATCH_SIZE; i++)
+        {
+            x[i] = cx + randomFloat(-BOX_SIZE - BALL_RADIUS, BALL_RADIUS);
+            y[i] = cy + randomFloat(-BOX_SIZE - BALL_RADIUS, BALL_RADIUS);
+        }
+
+        assertSameMasks(x, y, 1 + b % PHYSICS_BATCH_SIZE, BOX_SIZE, cx, cy, BALL_RADIUS);
+    }
+}
+
+void test_edge_cases(void)
+{
+    // Box corner at (100, 100): the circle touches each side or corner exactly, is just inside or just
+    // outside, or its center is on a side or inside the box
+    const float cx = 100.0f;
+    const float cy = 100.0f;
+    const float r = BALL_RADIUS;
+    const float d = r / 1.41421356f;
+    const float offsets[][2] = {
+        {-r, 0},          {r + BOX_SIZE, 0}, {0, -r},        {0, r + BOX_SIZE},      {-d, -d},
+        {-r + 0.001f, 0}, {-r - 0.001f, 0},  {BOX_SIZE, 0},  {BOX_SIZE / 2, BOX_SIZE / 2},
+        {0, 0},           {-6, -8},          {-6.001f, -8},  {BOX_SIZE + 6, BOX_SIZE + 8},
+    };
+    const int offsetCount = sizeof(offsets) / sizeof(offsets[0]);
+
+    float x[PHYSICS_BATCH_SIZE];
+    float y[PHYSICS_BATCH_SIZE];
+    for (int i = 0; i < PHYSICS_BATCH_SIZE; i++)
+    {
+        x[i] = cx - offsets[i % offsetCount][0];
+        y[i] = cy - offsets[i % offsetCount][1];
+    }
+
+    for (int count = 0; count <= PHYSICS_BATCH_SIZE; count++)
+    {
+        assertSameMasks(x, y, count, BOX_SIZE, cx, cy, r);
+        // Zero sized boxes and a zero radius: nothing can be hit
+        assertSameMasks(x, y, count, 0, cx, cy, r);
+        assertSameMasks(x, y, count, BOX_SIZE, cx, cy, 0);
+    }
+
+    // The same boxes shifted, so each case also lands in the vector lanes, the unrolled groups and the tail
+    for (int shift = 1; shift < 8; shift++)
+    {
+        assertSameMasks(x + shift, y + shift, PHYSICS_BATCH_SIZE - shift, BOX_SIZE, cx, cy, r);
+    }
+
+    // The last bit of a full batch
+    x[PHYSICS_BATCH_SIZE - 1] = cx;
+    y[PHYSICS_BATCH_SIZE - 1] = cy;
+    TEST_ASSERT_TRUE(physicsCircleHitsBoxes(x, y, PHYSICS_BATCH_SIZE, BOX_SIZE, cx, cy, r) & (1UL << 31));
+    assertSameMasks(x, y, PHYSICS_BATCH_SIZE, BOX_SIZE, cx, cy, r);
+}
+
+void test_world_scans(void)
+{
+    const int counts[] = {1, 31, 32, 33, 63, 64, 65, 200, PHYSICS_MAX_BODIES};
+
+    for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        physicsInit(&world, FIELD_WIDTH, FIELD_HEIGHT, BOX_SIZE);
+        for (int i = 0; i < counts[c]; i++)
+        {
+            physicsAdd(&world, randomFloat(0, FIELD_WIDTH - BOX_SIZE), randomFloat(0, FIELD_HEIGHT - BOX_SIZE), 0, 0);
+        }
+
+        for (int q = 0; q < 1000; q++)
+        {
+            float cx = randomFloat(0, FIELD_WIDTH);
+            float cy = randomFloat(0, FIELD_HEIGHT);
+
+            // Both scans return the first body hit, the grid returns any of them
+            int expected = physicsCollideCircleScanScalar(&world, cx, cy, BALL_RADIUS);
+            TEST_ASSERT_EQUAL_INT(expected, physicsCollideCircleScan(&world, cx, cy, BALL_RADIUS));
+            TEST_ASSERT_EQUAL(expected >= 0, physicsCollideCircleGrid(&world, cx, cy, BALL_RADIUS) >= 0);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_random_batches);
+    RUN_TEST(test_dense_batches);
+    RUN_TEST(test_edge_cases);
+    RUN_TEST(test_world_scans);
+    return UNITY_END();
+}
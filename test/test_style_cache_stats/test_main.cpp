@@ -0,0 +1,213 @@
+#include <unity.h>
+#include <stdio.h>
+#include "lvgl.h"
+#include "demos/lv_demos.h"
+#include "src/core/lv_obj_private.h"
+#include "src/core/lv_obj_style_private.h"
+
+// Runs lv_demo_widgets and lv_demo_benchmark on a headless display and prints the style property reads
+// per frame (LV_OBJ_STYLE_CACHE_STATS) and the memory of the property tables. Run it in the three cache
+// configurations:
+//   pio test -e native_style_cache_off -e native_style_cache_bits -e native_style_cache -v
+// The frame CRCs must be the same in all of them.
+
+#define SCREEN_WIDTH 480
+#define SCREEN_HEIGHT 272
+
+// Rendered frames of each demo, one LVGL refresh period apart
+#define FRAMES 600
+
+// The widgets demo switches to the next tab at this period
+#define TAB_SWITCH_FRAMES 60
+
+static uint32_t tickMs;
+static uint32_t frameCrc;
+static lv_display_t *display;
+static uint8_t buf[SCREEN_WIDTH * SCREEN_HEIGHT / 10 * 4];
+
+static uint32_t tickCb(void)
+{
+    return tickMs;
+}
+
+static void flushCb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    // FNV-1a of the flushed areas and their pixels
+    uint32_t size = lv_area_get_size(area) * lv_color_format_get_size(lv_display_get_color_format(disp));
+    const uint8_t *bytes[] = {(const uint8_t *)area, px_map};
+    const uint32_t sizes[] = {sizeof(*area), size};
+    for (int b = 0; b < 2; b++)
+    {
+        for (uint32_t i = 0; i < sizes[b]; i++)
+        {
+            frameCrc = (frameCrc ^ bytes[b][i]) * 16777619U;
+        }
+    }
+
+    lv_display_flush_ready(disp);
+}
+
+static lv_obj_t *findTabview(lv_obj_t *parent)
+{
+    for (uint32_t i = 0; i < lv_obj_get_child_count(parent); i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(parent, i);
+        if (lv_obj_check_type(child, &lv_tabview_class))
+        {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+// Objects of the tree that have allocated their resolved style property table
+static uint32_t countTables(lv_obj_t *obj)
+{
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    uint32_t tables = obj->style_prop_cache ? 1 : 0;
+#else
+    uint32_t tables = 0;
+#endif
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++)
+    {
+        tables += countTables(lv_obj_get_child(obj, i));
+    }
+    return tables;
+}
+
+static void runFrames(const char *name, lv_obj_t *tabview)
+{
+    lv_obj_style_cache_stats_t stats;
+    frameCrc = 2166136261U;
+    lv_obj_reset_style_cache_stats();
+
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        if (tabview && frame % TAB_SWITCH_FRAMES == TAB_SWITCH_FRAMES - 1)
+        {
+            uint32_t tabs = lv_tabview_get_tab_count(tabview);
+            lv_tabview_set_active(tabview, (lv_tabview_get_tab_active(tabview) + 1) % tabs, LV_ANIM_OFF);
+        }
+
+        tickMs += LV_DEF_REFR_PERIOD;
+        lv_timer_handler();
+    }
+
+    lv_obj_get_style_cache_stats(&stats);
+
+    uint32_t tables = countTables(lv_screen_active()) + countTables(lv_layer_top()) + countTables(lv_layer_sys());
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    uint32_t tableBytes = tables * sizeof(lv_obj_style_prop_cache_t);
+#else
+    uint32_t tableBytes = 0;
+#endif
+
+    char message[200];
+    snprintf(message, sizeof(message),
+             "%s (LV_OBJ_STYLE_CACHE %d, LV_OBJ_STYLE_PROP_CACHE_CNT %d): %lu reads, %lu resolved, %lu walks "
+             "per frame, %lu tables (%lu bytes), CRC %08lx",
+             name, LV_OBJ_STYLE_CACHE, LV_OBJ_STYLE_PROP_CACHE_CNT, (unsigned long)(stats.reads / FRAMES),
+             (unsigned long)(stats.resolved / FRAMES), (unsigned long)(stats.walks / FRAMES), (unsigned long)tables,
+             (unsigned long)tableBytes, (unsigned long)frameCrc);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_TRUE(stats.reads > 0);
+    TEST_ASSERT_TRUE(stats.resolved <= stats.reads);
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    TEST_ASSERT_TRUE(stats.resolved < stats.reads);
+#else
+    TEST_ASSERT_EQUAL_UINT32(stats.reads, stats.resolved);
+#endif
+}
+
+void setUp(void)
+{
+    tickMs = 0;
+    lv_init();
+    lv_tick_set_cb(tickCb);
+    display = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
+    lv_display_set_color_format(display, LV_COLOR_FORMAT_XRGB8888);
+    lv_display_set_buffers(display, buf, NULL, sizeof(buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flushCb);
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+void test_demo_widgets(void)
+{
+    lv_demo_widgets();
+    lv_obj_t *tabview = findTabview(lv_screen_active());
+    TEST_ASSERT_TRUE(tabview != NULL);
+    runFrames("lv_demo_widgets", tabview);
+}
+
+void test_demo_benchmark(void)
+{
+    lv_demo_benchmark();
+    runFrames("lv_demo_benchmark", NULL);
+}
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+// Style property reads of obj resolved from the styles, not found in its table
+static uint32_t resolvedReads(lv_obj_t *obj)
+{
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_reset_style_cache_stats();
+    lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+    lv_obj_get_style_cache_stats(&stats);
+    return stats.resolved;
+}
+
+void test_invalidation_scope(void)
+{
+    lv_obj_t *parent = lv_obj_create(lv_screen_active());
+    lv_obj_t *child = lv_obj_create(parent);
+    lv_obj_remove_style_all(child); // Without the theme's text color, it inherits the parent's one
+    lv_obj_t *sibling = lv_obj_create(lv_screen_active());
+    lv_obj_add_state(parent, LV_STATE_CHECKED); // Lets the state change below compare different styles
+    lv_obj_set_style_text_color(parent, lv_color_hex(0xFF0000), LV_STATE_CHECKED);
+
+    resolvedReads(child);
+    resolvedReads(sibling);
+    TEST_ASSERT_EQUAL_UINT32(0, resolvedReads(child));
+    TEST_ASSERT_EQUAL_UINT32(0, resolvedReads(sibling));
+
+    // A local style change of one object, like each step of a move: the others keep their tables
+    lv_obj_set_pos(parent, 10, 20);
+    TEST_ASSERT_EQUAL_UINT32(0, resolvedReads(child));
+    TEST_ASSERT_EQUAL_UINT32(0, resolvedReads(sibling));
+
+    // An inheritable property of the parent: its descendants are dropped too, not the sibling
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x00FF00), 0);
+    TEST_ASSERT_EQUAL_UINT32(2, resolvedReads(child));
+    TEST_ASSERT_EQUAL_UINT32(0, resolvedReads(sibling));
+
+    // The state of the parent: the inherited values of the child change
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, lv_color_to_u32(lv_obj_get_style_text_color(child, 0)) & 0xFFFFFF);
+    lv_obj_remove_state(parent, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_UINT32(2, resolvedReads(child));
+    TEST_ASSERT_EQUAL_UINT32(0, resolvedReads(sibling));
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, lv_color_to_u32(lv_obj_get_style_text_color(child, 0)) & 0xFFFFFF);
+
+    // A new parent: the child inherits from it
+    lv_obj_set_style_text_color(sibling, lv_color_hex(0x0000FF), 0);
+    lv_obj_set_parent(child, sibling);
+    TEST_ASSERT_EQUAL_UINT32(2, resolvedReads(child));
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, lv_color_to_u32(lv_obj_get_style_text_color(child, 0)) & 0xFFFFFF);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_demo_widgets);
+    RUN_TEST(test_demo_benchmark);
+#if LV_OBJ_STYLE_PROP_CACHE_CNT > 0
+    RUN_TEST(test_invalidation_scope);
+#endif
+    return UNITY_END();
+}
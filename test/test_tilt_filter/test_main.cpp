@@ -0,0 +1,162 @@
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include "tiltFilter.h"
+
+// Sensor scales: 16384 counts per g, 131 LSB per deg/s
+#define ACC_COUNTS_PER_DEG (16384.0 * 3.14159265 / 180.0)
+#define GYRO_LSB_PER_DPS 131.0
+
+static TiltFilter filter;
+
+static void feed(int accX, int accY, int gyroX, int gyroY, int samples)
+{
+    for (int i = 0; i < samples; i++)
+    {
+        Mpu6050Sample sample = {(int16_t)accX, (int16_t)accY, 16384, (int16_t)gyroX, (int16_t)gyroY, 0, 0};
+        tiltFilterUpdate(&filter, &sample);
+    }
+}
+
+// Calibrates with the board flat and still, without gyro bias
+static void calibrate(void)
+{
+    feed(0, 0, 0, 0, TILT_CALIBRATION_SAMPLES);
+    TEST_ASSERT_TRUE(tiltFilterCalibrated(&filter));
+}
+
+void setUp(void)
+{
+    tiltFilterInit(&filter);
+    srand(1234);
+}
+
+void tearDown(void)
+{
+}
+
+void test_calibration_follows_accelerometer(void)
+{
+    feed(1200, -800, 0, 0, TILT_CALIBRATION_SAMPLES - 1);
+    TEST_ASSERT_FALSE(tiltFilterCalibrated(&filter));
+    TEST_ASSERT_EQUAL_INT(1200, tiltFilterX(&filter));
+    TEST_ASSERT_EQUAL_INT(-800, tiltFilterY(&filter));
+
+    feed(1200, -800, 0, 0, 1);
+    TEST_ASSERT_TRUE(tiltFilterCalibrated(&filter));
+}
+
+void test_accelerometer_step_response(void)
+{
+    calibrate();
+
+    // Without rotation the accelerometer alone moves the tilt: a first order response with a time
+    // constant of 32768 / TILT_ACC_WEIGHT_Q15 samples (about 0.25 s)
+    const int step = 8000;
+    const double tau = 32768.0 / TILT_ACC_WEIGHT_Q15;
+    for (int n = 1; n <= 5 * (int)tau; n++)
+    {
+        feed(step, -step, 0, 0, 1);
+        double expected = step * (1.0 - pow(1.0 - 1.0 / tau, n));
+        TEST_ASSERT_INT_WITHIN(step / 100, (int)expected, tiltFilterX(&filter));
+        TEST_ASSERT_INT_WITHIN(step / 100, -(int)expected, tiltFilterY(&filter));
+    }
+
+    // Settled within the rounding of the Q12 blend
+    feed(step, -step, 0, 0, 10 * (int)tau);
+    TEST_ASSERT_INT_WITHIN(1, step, tiltFilterX(&filter));
+    TEST_ASSERT_INT_WITHIN(1, -step, tiltFilterY(&filter));
+}
+
+void test_rotation_latency(void)
+{
+    calibrate();
+
+    // The board rolls at 30 deg/s around both axes for 0.5 s then stops: the gyro must keep the
+    // tilt on the accelerometer, less than one sample behind, where the accelerometer alone would
+    // lag by its time constant
+    const double dps = 30.0;
+    const double countsPerSample = dps * ACC_COUNTS_PER_DEG / MPU6050_SAMPLE_RATE_HZ;
+    const int gyro = (int)lround(dps * GYRO_LSB_PER_DPS);
+    const int samples = MPU6050_SAMPLE_RATE_HZ / 2;
+
+    int tilt = 0;
+    for (int n = 1; n <= samples; n++)
+    {
+        // Rotating around Y tilts X down, rotating around X tilts Y up
+        tilt = (int)lround(n * countsPerSample);
+        feed(-tilt, tilt, gyro, gyro, 1);
+        TEST_ASSERT_INT_WITHIN((int)countsPerSample, -tilt, tiltFilterX(&filter));
+        TEST_ASSERT_INT_WITHIN((int)countsPerSample, tilt, tiltFilterY(&filter));
+    }
+
+    feed(-tilt, tilt, 0, 0, MPU6050_SAMPLE_RATE_HZ);
+    TEST_ASSERT_INT_WITHIN(2, -tilt, tiltFilterX(&filter));
+    TEST_ASSERT_INT_WITHIN(2, tilt, tiltFilterY(&filter));
+}
+
+void test_gyro_bias_calibration(void)
+{
+    const int biasX = -37;
+    const int biasY = 52;
+
+    // Noisy still samples: the bias is their average
+    for (int i = 0; i < TILT_CALIBRATION_SAMPLES; i++)
+    {
+        feed(0, 0, biasX + rand() % 7 - 3, biasY + rand() % 7 - 3, 1);
+    }
+    TEST_ASSERT_TRUE(tiltFilterCalibrated(&filter));
+    TEST_ASSERT_INT_WITHIN(16, biasX * 16, filter.gyroBiasX);
+    TEST_ASSERT_INT_WITHIN(16, biasY * 16, filter.gyroBiasY);
+
+    // Still board: once removed, the bias does not tilt the output. Uncorrected, 52 LSB would hold
+    // it about 28 counts away from the accelerometer.
+    for (int i = 0; i < 10 * MPU6050_SAMPLE_RATE_HZ; i++)
+    {
+        feed(500, -500, biasX + rand() % 7 - 3, biasY + rand() % 7 - 3, 1);
+    }
+    TEST_ASSERT_INT_WITHIN(3, 500, tiltFilterX(&filter));
+    TEST_ASSERT_INT_WITHIN(3, -500, tiltFilterY(&filter));
+}
+
+void test_saturation(void)
+{
+    calibrate();
+
+    // Full scale accelerometer, both signs
+    feed(32767, -32768, 0, 0, 20 * MPU6050_SAMPLE_RATE_HZ);
+    TEST_ASSERT_INT_WITHIN(1, 32767, tiltFilterX(&filter));
+    TEST_ASSERT_EQUAL_INT(-32768, tiltFilterY(&filter));
+
+    // Full scale rotation pushing further out: the output stays at the extremes without wrapping
+    for (int i = 0; i < 20 * MPU6050_SAMPLE_RATE_HZ; i++)
+    {
+        feed(32767, -32768, -32768, -32768, 1);
+        TEST_ASSERT_GREATER_OR_EQUAL(32766, tiltFilterX(&filter));
+        TEST_ASSERT_EQUAL_INT(-32768, tiltFilterY(&filter));
+    }
+
+    // And in the other direction
+    for (int i = 0; i < 20 * MPU6050_SAMPLE_RATE_HZ; i++)
+    {
+        feed(-32768, 32767, 32767, 32767, 1);
+    }
+    TEST_ASSERT_EQUAL_INT(-32768, tiltFilterX(&filter));
+    TEST_ASSERT_EQUAL_INT(32767, tiltFilterY(&filter));
+
+    // Back to flat and still: the filter recovers
+    feed(0, 0, 0, 0, 20 * MPU6050_SAMPLE_RATE_HZ);
+    TEST_ASSERT_INT_WITHIN(1, 0, tiltFilterX(&filter));
+    TEST_ASSERT_INT_WITHIN(1, 0, tiltFilterY(&filter));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_calibration_follows_accelerometer);
+    RUN_TEST(test_accelerometer_step_response);
+    RUN_TEST(test_rotation_latency);
+    RUN_TEST(test_gyro_bias_calibration);
+    RUN_TEST(test_saturation);
+    return UNITY_END();
+}